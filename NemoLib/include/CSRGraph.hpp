@@ -0,0 +1,506 @@
+#pragma once
+
+#ifndef __CSR_GRAPH_HPP
+#define __CSR_GRAPH_HPP
+
+#include <vector>      // vector
+#include <string>      // string
+#include <cstddef>     // size_t
+#include <cstdint>     // uint64_t, uint8_t
+#include <algorithm>   // binary_search, upper_bound
+#include <memory>      // shared_ptr
+
+#include "Config.hpp"
+#include "Graph.hpp"    // Graph
+#include "EdgeListReader.hpp" // EdgeList
+#include "graph64.hpp"  // vertex
+#include "Subgraph.hpp" // Subgraph
+#include "InlineSubgraph.hpp" // InlineSubgraph
+
+
+/** @brief How the vertices of a CSRGraph are numbered.
+  * @remark ESU only extends a root to larger vertices, so the numbering
+  *         shapes the search tree. Both reorderings give high degree or
+  *         deeply nested vertices the largest numbers, and with them the
+  *         smallest subtrees, which evens out the work per root. Reverse
+  *         Cuthill-McKee instead aims for locality, it numbers vertices
+  *         breadth first so that the neighbors of a vertex, and their
+  *         neighbors, sit close together in the neighbor array.
+  */
+enum class VertexOrder
+{
+    //! keep the numbering of the Graph
+    NONE,
+    //! ascending degree
+    DEGREE,
+    //! degeneracy order, the order in which a k-core decomposition peels vertices
+    DEGENERACY,
+    //! reverse Cuthill-McKee
+    RCM
+}; // end enum VertexOrder
+
+
+/** @brief Parses "none", "degree", "degeneracy" or "rcm".
+  * @throws std::invalid_argument For any other name.
+  */
+VertexOrder parse_vertex_order(const std::string& kr_str_NAME_);
+
+
+/** @brief Whether a CSRGraph also keeps a dense bit matrix of its edges.*/
+enum class DenseAdjacency
+{
+    //! only for graphs of at most _DENSE_ADJACENCY_MAX_VERTICES vertices
+    AUTO,
+    //! always
+    ON,
+    //! never
+    OFF
+}; // end enum DenseAdjacency
+
+
+/** @brief Parses "auto", "on" or "off".
+  * @throws std::invalid_argument For any other name.
+  */
+DenseAdjacency parse_dense_adjacency(const std::string& kr_str_NAME_);
+
+
+/** @brief How a CSRGraph snapshot is laid out.
+  * @remark Implicitly constructible from a VertexOrder so that callers
+  *         only choosing the order can pass it directly.
+  */
+struct CSROptions
+{
+    CSROptions(const VertexOrder k_ORDER_ = VertexOrder::NONE, const DenseAdjacency k_DENSE_ = DenseAdjacency::AUTO)
+     : m_order(k_ORDER_), m_dense(k_DENSE_)
+    {}
+
+    //! how to renumber the vertices
+    VertexOrder m_order;
+    //! whether to keep a bit matrix for edge tests
+    DenseAdjacency m_dense;
+}; // end struct CSROptions
+
+
+/** @brief Immutable compressed sparse row snapshot of a Graph.
+  * @remark The neighbors of every vertex are stored sorted in one
+  *         contiguous array, so neighbor scans are sequential and
+  *         adjacency tests are a binary search instead of a hash lookup.
+  *         Small graphs also get a bit matrix, which turns adjacency tests
+  *         into a single bit test. In larger graphs only the hubs get a row
+  *         of bits, so tests against a hub stay O(1) however many
+  *         neighbors it has while everything else keeps its sorted array.
+  *         Directed graphs keep one byte of edge directions per neighbor,
+  *         parallel to the neighbor array, in place of a hash map of edges.
+  *         The snapshot is built once per graph and is what the
+  *         enumerators read from. It may renumber the vertices, in which
+  *         case subgraphs have to be mapped back with @see restore before
+  *         they are reported. A snapshot can be saved to a binary file and
+  *         memory-mapped back, in which case its arrays are read from the
+  *         mapping as they are and the page cache copy is shared by every
+  *         process that maps the same file.
+  */
+class CSRGraph
+{
+public:
+    /** @brief A read-only view of the sorted neighbors of one vertex.*/
+    class NeighborRange
+    {
+    public:
+        NeighborRange(const vertex* p_begin_, const vertex* p_end_) noexcept
+         : mp_begin(p_begin_), mp_end(p_end_)
+        {}
+
+        const vertex* begin(void) const noexcept { return mp_begin; }
+        const vertex* end(void) const noexcept { return mp_end; }
+
+        std::size_t size(void) const noexcept { return static_cast<std::size_t>(mp_end - mp_begin); }
+        bool empty(void) const noexcept { return mp_begin == mp_end; }
+
+        vertex operator[](const std::size_t ku_li_I_) const noexcept { return mp_begin[ku_li_I_]; }
+
+        /** @brief The neighbors greater than the given vertex.*/
+        NeighborRange above(const vertex k_V_) const noexcept
+        {
+            return NeighborRange(std::upper_bound(mp_begin, mp_end, k_V_), mp_end);
+        } // end method above
+
+    private:
+        //! first neighbor
+        const vertex* mp_begin;
+        //! one past the last neighbor
+        const vertex* mp_end;
+    }; // end class NeighborRange
+
+
+    /** @brief How far apart adjacent vertices are numbered.*/
+    struct Locality
+    {
+        //! mean of log2(|u - v| + 1) over all edges, a proxy for the cache
+        //! lines touched when scanning the neighbors of neighbors
+        double md_mean_log_gap;
+        //! largest |u - v| over all edges
+        std::size_t mu_li_bandwidth;
+    }; // end struct Locality
+
+
+    /** @brief Takes a snapshot of a graph.
+      * @param kr_OPTIONS_ How to renumber the vertices of the snapshot and
+      *        whether to keep a bit matrix
+      */
+    explicit CSRGraph(const Graph& kr_GRAPH_, const CSROptions& kr_OPTIONS_ = CSROptions{});
+
+
+    /** @brief Builds a snapshot straight from an edge list, without a Graph.
+      * @remark Both ends of every edge are packed into one sortable key per
+      *         row, the keys are sorted in parallel and repeated edges are
+      *         merged in a single pass. The snapshot is numbered as the
+      *         Graph of the same edge list would be.
+      */
+    explicit CSRGraph(const EdgeList& kr_EDGES_, const CSROptions& kr_OPTIONS_ = CSROptions{});
+
+
+    /** @brief Maps a snapshot written by @see save.
+      * @param k_DENSE_ Whether to build a bit matrix, the bit matrix and
+      *        the hub bitsets are not stored in the file
+      * @throws std::runtime_error If the file can't be read, is not a
+      *         snapshot, is of another format version or is truncated.
+      * @remark Only the header is checked, the arrays are trusted as they
+      *         were written so that opening never reads the whole file.
+      */
+    static CSRGraph open_mapped(const std::string& kr_str_PATH_, const DenseAdjacency k_DENSE_ = DenseAdjacency::AUTO);
+
+
+    /** @brief Whether a file starts like a snapshot written by @see save,
+      *        rather than being a text edge list.
+      */
+    static bool is_mapped_format(const std::string& kr_str_PATH_);
+
+
+    // the arrays may point into the owned vectors, which survive a move
+    CSRGraph(CSRGraph&&) = default;
+    CSRGraph& operator=(CSRGraph&&) = default;
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+
+    /** @brief Writes the snapshot, with the names of its vertices, to a
+      *        binary file.
+      * @param kr_vect_NAMES_ The name of every vertex of the Graph, by
+      *        number, or empty to write no names
+      * @throws std::runtime_error If the file can't be written.
+      * @remark The file is a header followed by the offsets, neighbors,
+      *         edge directions, renumbering and names, each as a native
+      *         array starting on an 8 byte boundary. The header carries a
+      *         format version that @see open_mapped insists on. The file is
+      *         written next to the target and renamed over it.
+      */
+    void save(const std::string& kr_str_PATH_, const std::vector<std::string>& kr_vect_NAMES_) const;
+
+
+    /** @brief Number of vertices.*/
+    std::size_t getSize(void) const noexcept
+    {
+        return mu_li_n;
+    } // end method getSize
+
+
+    /** @brief Number of undirected edges.*/
+    std::size_t getEdgeCount(void) const noexcept
+    {
+        return mp_offsets[mu_li_n] / 2;
+    } // end method getEdgeCount
+
+
+    /** @brief Whether the snapshotted graph is directed.*/
+    bool isDirected(void) const noexcept
+    {
+        return m_b_directed;
+    } // end method isDirected
+
+
+    /** @brief The sorted neighbors of a vertex, ignoring direction.*/
+    NeighborRange getAdjacencyList(const vertex k_V_) const noexcept
+    {
+        return NeighborRange(mp_neighbors + mp_offsets[k_V_], mp_neighbors + mp_offsets[k_V_ + 1]);
+    } // end method getAdjacencyList
+
+
+    /** @brief Number of neighbors of a vertex, ignoring direction.*/
+    std::size_t degree(const vertex k_V_) const noexcept
+    {
+        return mp_offsets[k_V_ + 1] - mp_offsets[k_V_];
+    } // end method degree
+
+
+    /** @brief Number of edges leaving a vertex, its degree if undirected.*/
+    std::size_t outDegree(const vertex k_V_) const noexcept
+    {
+        return directedDegree(k_V_, DIR_U_T_V);
+    } // end method outDegree
+
+
+    /** @brief Number of edges entering a vertex, its degree if undirected.*/
+    std::size_t inDegree(const vertex k_V_) const noexcept
+    {
+        return directedDegree(k_V_, DIR_V_T_U);
+    } // end method inDegree
+
+
+    /** @brief Whether two vertices are adjacent, ignoring direction.*/
+    bool hasEdge(const vertex k_U_, const vertex k_V_) const noexcept
+    {
+        if (false == m_vect_matrix.empty())
+        {
+            const std::size_t ku_li_bit = k_U_ * mu_li_row_words * 64 + k_V_;
+
+            return 0 != ((m_vect_matrix[ku_li_bit / 64] >> (ku_li_bit % 64)) & 1);
+        } // end if
+
+        if (false == m_vect_hub_rows.empty())
+        {
+            if (ku_NOT_A_HUB != m_vect_hub_rows[k_U_])
+            {
+                return testHubBit(m_vect_hub_rows[k_U_], k_V_);
+            } // end if
+
+            if (ku_NOT_A_HUB != m_vect_hub_rows[k_V_])
+            {
+                return testHubBit(m_vect_hub_rows[k_V_], k_U_);
+            } // end if
+        } // end if
+
+        // the shorter list is the cheaper one to search
+        if (degree(k_U_) > degree(k_V_))
+        {
+            return hasEdge(k_V_, k_U_);
+        } // end if
+
+        const NeighborRange k_neighbors = getAdjacencyList(k_U_);
+
+        return std::binary_search(k_neighbors.begin(), k_neighbors.end(), k_V_);
+    } // end method hasEdge
+
+
+    /** @brief The directions of the edge between two vertices, relative
+      *        to the first, @see graph64.hpp
+      * @return DIR_U_T_V for u -> v, DIR_V_T_U for v -> u, UNDIR_U_V for
+      *         both or an undirected edge and NOEDGE_UV if not adjacent.
+      */
+    edgetype edgeType(const vertex k_U_, const vertex k_V_) const noexcept
+    {
+        if (false == hasEdge(k_U_, k_V_))
+        {
+            return NOEDGE_UV;
+        } // end if
+
+        if (false == m_b_directed)
+        {
+            return UNDIR_U_V;
+        } // end if
+
+        const NeighborRange k_neighbors = getAdjacencyList(k_U_);
+        const vertex* p_it = std::lower_bound(k_neighbors.begin(), k_neighbors.end(), k_V_);
+
+        return mp_types[p_it - mp_neighbors];
+    } // end method edgeType
+
+
+    /** @brief Whether edge tests use a bit matrix.*/
+    bool isDense(void) const noexcept
+    {
+        return false == m_vect_matrix.empty();
+    } // end method isDense
+
+
+    /** @brief Number of vertices with a neighbor bitset.*/
+    std::size_t getHubCount(void) const noexcept
+    {
+        return m_vect_hub_rows.empty() ? 0 : m_vect_hub_bits.size() / mu_li_row_words;
+    } // end method getHubCount
+
+
+    /** @brief Measures how local the numbering of the snapshot is.*/
+    Locality locality(void) const;
+
+
+    /** @brief Measures how local the numbering of an edge list is, without
+      *        building a snapshot of it.
+      * @remark Repeated edges are counted as often as they were read.
+      */
+    static Locality locality(const EdgeList& kr_EDGES_);
+
+
+    /** @brief Whether the vertices were renumbered.*/
+    bool isRelabeled(void) const noexcept
+    {
+        return nullptr != mp_original;
+    } // end method isRelabeled
+
+
+    /** @brief The vertex of the Graph a vertex of the snapshot stands for.*/
+    vertex original(const vertex k_V_) const noexcept
+    {
+        return nullptr == mp_original ? k_V_ : mp_original[k_V_];
+    } // end method original
+
+
+    /** @brief The vertex of the snapshot standing for a vertex of the Graph.*/
+    vertex renumbered(const vertex k_V_) const noexcept
+    {
+        return nullptr == mp_renumbered ? k_V_ : mp_renumbered[k_V_];
+    } // end method renumbered
+
+
+    /** @brief The name a vertex of the Graph was read under.
+      * @return Empty unless the snapshot was mapped from a file whose
+      *         Graph was read from an edge list.
+      */
+    std::string getName(const vertex k_V_) const
+    {
+        if (nullptr == mp_name_offsets)
+        {
+            return std::string();
+        } // end if
+
+        return std::string(mp_names + mp_name_offsets[k_V_], mp_names + mp_name_offsets[k_V_ + 1]);
+    } // end method getName
+
+
+    /** @brief Maps the vertices of a subgraph back to the numbering of the
+      *        Graph, so that it can be labeled and reported.
+      */
+    void restore(Subgraph& r_subgraph_) const
+    {
+        if (nullptr == mp_original)
+        {
+            return;
+        } // end if
+
+        std::vector<vertex>& r_vect_nodes = r_subgraph_.getNodes();
+
+        for (std::size_t i{0}; i < r_subgraph_.getSize(); i++)
+        {
+            r_vect_nodes[i] = mp_original[r_vect_nodes[i]];
+        } // end for i
+    } // end method restore
+
+
+    /** @copydoc restore(Subgraph&) const*/
+    void restore(InlineSubgraph& r_subgraph_) const
+    {
+        if (nullptr == mp_original)
+        {
+            return;
+        } // end if
+
+        for (vertex& r_v : r_subgraph_)
+        {
+            r_v = mp_original[r_v];
+        } // end for r_v
+    } // end method restore
+
+private:
+    //! marks vertices without a neighbor bitset
+    static constexpr std::uint32_t ku_NOT_A_HUB = 0xFFFFFFFFu;
+
+
+    /** @brief Tests bit v of the bitset of the given hub.*/
+    bool testHubBit(const std::uint32_t ku_HUB_, const vertex k_V_) const noexcept
+    {
+        return 0 != ((m_vect_hub_bits[ku_HUB_ * mu_li_row_words + k_V_ / 64] >> (k_V_ % 64)) & 1);
+    } // end method testHubBit
+
+
+    CSRGraph(void) = default;
+
+
+    /** @brief Number of neighbors with the given direction bit.*/
+    std::size_t directedDegree(const vertex k_V_, const edgetype k_DIRECTION_) const noexcept
+    {
+        if (false == m_b_directed)
+        {
+            return degree(k_V_);
+        } // end if
+
+        std::size_t u_li_degree{0};
+
+        for (std::size_t i{mp_offsets[k_V_]}; i < mp_offsets[k_V_ + 1]; i++)
+        {
+            u_li_degree += (0 != (mp_types[i] & k_DIRECTION_));
+        } // end for i
+
+        return u_li_degree;
+    } // end method directedDegree
+
+
+    /** @brief Points the arrays at the owned vectors.*/
+    void bindOwned(void) noexcept;
+
+
+    /** @brief Renumbers the owned arrays of a snapshot that isn't yet.
+      * @param vect_original_ The current vertex behind every new vertex
+      */
+    void renumber(std::vector<vertex> vect_original_);
+
+
+    /** @brief Builds the bit matrix, or the hub bitsets if there is none.*/
+    void buildEdgeTests(const DenseAdjacency k_DENSE_);
+
+
+    /** @brief Gives every vertex of high enough degree a neighbor bitset.*/
+    void buildHubBitsets(void);
+
+    //! number of vertices
+    std::size_t mu_li_n = 0;
+
+    //! start of the neighbors of every vertex, plus the end of the last
+    const std::size_t* mp_offsets = nullptr;
+    //! the neighbors of all vertices, each vertex's sorted ascending
+    const vertex* mp_neighbors = nullptr;
+    //! directions of every neighbor relative to its vertex, directed only
+    const std::uint8_t* mp_types = nullptr;
+    //! vertex of the Graph behind every vertex, nullptr if not renumbered
+    const vertex* mp_original = nullptr;
+    //! vertex of the snapshot of every vertex of the Graph, nullptr if not
+    //! renumbered
+    const vertex* mp_renumbered = nullptr;
+    //! start of the name of every vertex of the Graph, plus the end of the
+    //! last, nullptr unless mapped from a file with names
+    const std::uint64_t* mp_name_offsets = nullptr;
+    //! the names of all vertices of the Graph, back to back
+    const char* mp_names = nullptr;
+
+    //! the file the arrays point into, empty if they point into the vectors
+    std::shared_ptr<const void> m_p_mapping;
+
+    //! owned arrays of a snapshot taken of a Graph
+    std::vector<std::size_t> m_vect_offsets;
+    std::vector<vertex> m_vect_neighbors;
+
+    //! one row of bits per vertex, empty if edge tests search the neighbors
+    std::vector<std::uint64_t> m_vect_matrix;
+    //! words per row of the bit matrix or of a hub bitset
+    std::size_t mu_li_row_words = 0;
+
+    //! bitset row of every vertex, ku_NOT_A_HUB if it has none, empty if
+    //! there are no hubs
+    std::vector<std::uint32_t> m_vect_hub_rows;
+    //! the bitsets of all hubs, one row each
+    std::vector<std::uint64_t> m_vect_hub_bits;
+
+    std::vector<std::uint8_t> m_vect_types;
+    std::vector<vertex> m_vect_original;
+    std::vector<vertex> m_vect_renumbered;
+
+    //! whether the snapshotted graph is directed
+    bool m_b_directed = false;
+}; // end class CSRGraph
+
+
+/** @brief Maps a snapshot written by CSRGraph::save as it is, or reads any
+  *        other graph file with read_edge_list and snapshots it, logging
+  *        what the renumbering does to the memory locality of the graph.
+  */
+CSRGraph read_graph(const std::string& kr_str_PATH_, const bool kb_DIRECTED_, const ParseOptions& kr_PARSE_OPTIONS_, const CSROptions& kr_CSR_OPTIONS_);
+
+#endif // !__CSR_GRAPH_HPP
@@ -11,6 +11,22 @@
 		#define _USE_CUDA 0			// use CUDA code for random graph building
 	#endif
 
+	#ifndef _USE_NAUTY
+		#define _USE_NAUTY 0		// link nauty for in-process canonical labeling
+	#endif
+
+	#ifndef _USE_MOTIF_CLASS_TABLE
+		#define _USE_MOTIF_CLASS_TABLE 1	// classify small motifs by table lookup
+	#endif
+
+	#ifndef _DENSE_ADJACENCY_MAX_VERTICES
+		#define _DENSE_ADJACENCY_MAX_VERTICES 16384	// largest graph given a bit matrix (n^2/8 bytes) by default
+	#endif
+
+	#ifndef _HUB_MIN_DEGREE
+		#define _HUB_MIN_DEGREE 1024	// smallest degree for which a vertex also keeps a neighbor bitset
+	#endif
+
 	#ifdef __has_include
 		#define _CAN_CHECK_INCLUDE
 	#endif
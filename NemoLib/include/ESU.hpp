@@ -32,14 +32,31 @@ public:
 	 * @param subgraphs the SubgraphEnumerationResult into which to enumerated
 	 *                  Subgraphs will be stored.
 	 * @param subgraphSize the size of the target Subgraphs
+	 * @param csr_options how to lay out the graph for enumerating
 	 */
-	static void enumerate(Graph& graph, SubgraphEnumerationResult* subgraphs, int subgraphSize, const std::string& labelg_path)
+	static void enumerate(Graph& graph, SubgraphEnumerationResult* subgraphs, int subgraphSize, const LabelGOptions& labelg_options, const CSROptions& csr_options = CSROptions{})
 	{
-		NautyLink nautylink(labelg_path, subgraphSize, graph.getEdges(), graph.isDirected());
+		const CSRGraph csr(graph, csr_options);
+
+		enumerate(csr, subgraphs, subgraphSize, labelg_options);
+	} // end method enumerate
+
+   /**
+	 * Enumerates Subgraphs of a snapshot, which may have been mapped from
+	 * a file, using the ESU algorithm.
+	 *
+	 * @param graph the CSR snapshot on which to execute ESU
+	 * @param subgraphs the SubgraphEnumerationResult into which to enumerated
+	 *                  Subgraphs will be stored.
+	 * @param subgraphSize the size of the target Subgraphs
+	 */
+	static void enumerate(const CSRGraph& graph, SubgraphEnumerationResult* subgraphs, int subgraphSize, const LabelGOptions& labelg_options)
+	{
+		NautyLink nautylink(labelg_options, subgraphSize, graph);
 
 		for (std::size_t i = 0; i < graph.getSize(); i++)
 		{
-			enumerate(graph, subgraphs, subgraphSize, i, nautylink);
+			enumerate(graph, subgraphs, subgraphSize, static_cast<vertex>(i), nautylink);
 		} // end for i
 	} // end method enumerate
 
@@ -48,13 +65,13 @@ public:
 	 * given node. Allows for more control over the order the order of 
 	 * execution, but does not perform a full enumeration.
 	 *
-	 * @param graph the graph on which to execute ESU
+	 * @param graph the CSR snapshot of the graph on which to execute ESU
 	 * @param subgraphs the data structure to which results are written
 	 * @param subgraphSize the target subgraph size to enumerate
 	 * @param vertex the graph vertex at which to execute
      * @param nautylink after initialize from the previous
 	 */
-    inline static void enumerate(Graph& graph, SubgraphEnumerationResult* subgraphs, int subgraphSize, vertex vertexV, NautyLink& nautylink)
+    inline static void enumerate(const CSRGraph& graph, SubgraphEnumerationResult* subgraphs, int subgraphSize, vertex vertexV, NautyLink& nautylink)
 	{
 		std::vector<double> probs(subgraphSize, 1.0);
 		RandESU::enumerate(graph, subgraphs, subgraphSize, probs, vertexV, nautylink);
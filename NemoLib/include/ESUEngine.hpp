@@ -0,0 +1,440 @@
+#pragma once
+
+#ifndef __ESU_ENGINE_HPP
+#define __ESU_ENGINE_HPP
+
+#include <array>       // array
+#include <string>      // to_string
+#include <vector>      // vector
+#include <cstddef>     // size_t
+#include <cassert>     // assert
+#include <algorithm>   // copy_n
+#include <stdexcept>   // invalid_argument
+#include <utility>     // move
+#include <type_traits> // conditional_t
+
+#include "Config.hpp"
+#include "CSRGraph.hpp"       // CSRGraph
+#include "InlineSubgraph.hpp" // InlineSubgraph
+#include "ESUSplitter.hpp"    // ESUSplitter, ESUSubtree
+#include "NautyLink.hpp"      // NautyLink
+#include "Utility.hpp"        // get_random_in_range
+
+
+/** @brief Walks the ESU tree of one root without recursion.
+  * @tparam K The motif size the engine is compiled for, 0 for one chosen at
+  *         run time. A fixed size keeps the subgraph, the frames and the
+  *         probabilities in arrays, so every loop over them has a constant
+  *         trip count.
+  * @remark The levels of the tree are frames on an explicit stack. The
+  *         extensions of all levels share one buffer, each frame owning the
+  *         slice between its marker and the next frame's. The subgraph grows
+  *         and shrinks in place and the leaves are copied into a buffer of
+  *         InlineSubgraphs that is handed to the result as it is. Every
+  *         buffer keeps its storage from root to root, so once an engine has
+  *         walked its largest tree the walk no longer touches the heap. The
+  *         vertices, leaves and random draws of RAND-ESU come in the same
+  *         order as in the recursive walk, so the subgraphs found are exactly
+  *         the same.
+  * @remark Given an ESUSplitter, the walk polls it and hands the back half
+  *         of what is left at a node of size 1 or 2 to another worker while
+  *         the pool runs short of jobs. A frame then stops short of the end
+  *         of its extension, the children of the entries it keeps still
+  *         extend the entries given away.
+  */
+template <std::size_t K>
+class ESUEngine
+{
+public:
+    //! leaves are labeled in batches of this many subgraphs
+    static constexpr std::size_t ku_li_LEAF_BATCH_SIZE = 4096;
+    //! the splitter is asked once every this many steps, a power of two
+    static constexpr std::size_t ku_li_SPLIT_POLL = 1024;
+    //! nodes up to this size may give part of their extension away
+    static constexpr std::size_t ku_li_SPLIT_MAX_SIZE = 2;
+
+
+    /** @brief The engine of the calling thread.*/
+    static ESUEngine& instance(void)
+    {
+        thread_local ESUEngine s_engine;
+        return s_engine;
+    } // end method instance
+
+
+    /** @brief Enumerates the subgraphs whose smallest vertex is the root.
+      * @param kr_vect_PROBS_ The RAND-ESU probability of descending to every
+      *        level of the tree, all 1.0 for a full enumeration
+      * @throws std::invalid_argument If the size isn't K, or there are fewer
+      *         probabilities than levels.
+      * @param p_splitter_ Takes the subtrees given away while walking,
+      *        nullptr to walk the whole tree here
+      * @remark The leaves are restored to the numbering of the Graph and
+      *         added to the result, the last batch before returning.
+      */
+    template <typename T>
+    void enumerate(const CSRGraph& kr_GRAPH_, T* p_subgraphs_, const std::size_t ku_li_ORDER_, const std::vector<double>& kr_vect_PROBS_, const vertex k_ROOT_, NautyLink& r_nautylink_, ESUSplitter* p_splitter_ = nullptr)
+    {
+        prepare(ku_li_ORDER_, kr_vect_PROBS_);
+
+        mu_li_size = 0;
+        m_arr_nodes[mu_li_size++] = k_ROOT_;
+
+        if (true == should_extend(m_arr_probs[1]))
+        {
+            // neighbors are sorted, so the ones greater than the root
+            // are a suffix
+            const CSRGraph::NeighborRange k_roots = kr_GRAPH_.getAdjacencyList(k_ROOT_).above(k_ROOT_);
+
+            m_vect_extension.assign(k_roots.begin(), k_roots.end());
+            m_arr_frames[0] = Frame{0, 0, m_vect_extension.size(), m_vect_extension.size()};
+            mu_li_depth = 1;
+            mu_li_base = 1;
+
+            walk<T>(kr_GRAPH_, p_subgraphs_, r_nautylink_, p_splitter_);
+        } // end if
+
+        if (false == m_vect_leaves.empty())
+        {
+            flush<T>(kr_GRAPH_, p_subgraphs_, r_nautylink_);
+        } // end if
+    } // end method enumerate
+
+
+    /** @brief Enumerates the subgraphs of a subtree another engine split off.
+      * @param p_splitter_ Takes the subtrees given away in turn, nullptr to
+      *        walk the whole subtree here
+      * @throws std::invalid_argument As enumerate.
+      */
+    template <typename T>
+    void enumerate(const CSRGraph& kr_GRAPH_, T* p_subgraphs_, const std::size_t ku_li_ORDER_, const std::vector<double>& kr_vect_PROBS_, const ESUSubtree& kr_SUBTREE_, NautyLink& r_nautylink_, ESUSplitter* p_splitter_ = nullptr)
+    {
+        prepare(ku_li_ORDER_, kr_vect_PROBS_);
+
+        assert(kr_SUBTREE_.m_vect_nodes.size() + 1 < ku_li_ORDER_);
+        assert(kr_SUBTREE_.mu_li_count <= kr_SUBTREE_.m_vect_extension.size());
+
+        mu_li_size = kr_SUBTREE_.m_vect_nodes.size();
+        std::copy_n(kr_SUBTREE_.m_vect_nodes.begin(), mu_li_size, m_arr_nodes.begin());
+
+        m_vect_extension.assign(kr_SUBTREE_.m_vect_extension.begin(), kr_SUBTREE_.m_vect_extension.end());
+        m_arr_frames[0] = Frame{0, 0, kr_SUBTREE_.mu_li_count, m_vect_extension.size()};
+        mu_li_depth = 1;
+        mu_li_base = mu_li_size;
+
+        walk<T>(kr_GRAPH_, p_subgraphs_, r_nautylink_, p_splitter_);
+
+        if (false == m_vect_leaves.empty())
+        {
+            flush<T>(kr_GRAPH_, p_subgraphs_, r_nautylink_);
+        } // end if
+    } // end method enumerate
+
+private:
+    /** @brief One level of the tree.*/
+    struct Frame
+    {
+        //! where the extension of the level starts in the buffer
+        std::size_t u_li_begin;
+        //! the next vertex of the extension to add
+        std::size_t u_li_cursor;
+        //! one past the last vertex to add, the rest was given away
+        std::size_t u_li_stop;
+        //! one past the end of the extension
+        std::size_t u_li_end;
+    }; // end struct Frame
+
+
+    //! one slot per level, a vector when the size is chosen at run time
+    template <typename U>
+    using Slots = std::conditional_t<0 == K, std::vector<U>, std::array<U, K>>;
+
+
+    /** @brief The motif size, a constant unless K is 0.*/
+    std::size_t order(void) const noexcept
+    {
+        if constexpr (0 == K)
+        {
+            return mu_li_order;
+        } // end if
+        else
+        {
+            return K;
+        } // end else
+    } // end method order
+
+
+    /** @brief Sizes the buffers for the motif size and copies the
+      *        probabilities, the last one decides the leaves.
+      */
+    void prepare(const std::size_t ku_li_ORDER_, const std::vector<double>& kr_vect_PROBS_)
+    {
+        if constexpr (0 == K)
+        {
+            if (ku_li_ORDER_ > InlineSubgraph::ku_li_CAPACITY)
+            {
+                throw std::invalid_argument("ESUEngine can't enumerate subgraphs of size " + std::to_string(ku_li_ORDER_) + ", the most is " + std::to_string(InlineSubgraph::ku_li_CAPACITY));
+            } // end if
+
+            if (mu_li_order != ku_li_ORDER_)
+            {
+                mu_li_order = ku_li_ORDER_;
+                m_arr_nodes.resize(ku_li_ORDER_);
+                m_arr_frames.resize(ku_li_ORDER_);
+                m_arr_probs.resize(ku_li_ORDER_);
+            } // end if
+        } // end if
+        else
+        {
+            if (K != ku_li_ORDER_)
+            {
+                throw std::invalid_argument("ESUEngine<" + std::to_string(K) + "> can't enumerate subgraphs of size " + std::to_string(ku_li_ORDER_));
+            } // end if
+        } // end else
+
+        m_vect_leaves.reserve(ku_li_LEAF_BATCH_SIZE);
+
+        if (ku_li_ORDER_ < 2 || kr_vect_PROBS_.size() < ku_li_ORDER_)
+        {
+            throw std::invalid_argument("Expected a probability for each of the " + std::to_string(ku_li_ORDER_) + " levels, got " + std::to_string(kr_vect_PROBS_.size()));
+        } // end if
+
+        std::copy_n(kr_vect_PROBS_.begin(), ku_li_ORDER_, m_arr_probs.begin());
+        md_leaf_prob = kr_vect_PROBS_.back();
+    } // end method prepare
+
+
+    /** @brief Draws whether to descend, precondition: 0.0 <= prob <= 1.0.*/
+    static bool should_extend(const double kd_PROB_)
+    {
+        assert(kd_PROB_ >= 0.0 && kd_PROB_ <= 1.0);
+
+        return kd_PROB_ == 1.0 ? true : kd_PROB_ == 0.0 ? false : get_random_in_range(0, 100) <= (kd_PROB_ * 100.0);
+    } // end method should_extend
+
+
+    /** @brief Whether a vertex is neither in the subgraph nor adjacent to
+      *        any of its vertices.
+      */
+    bool is_exclusive(const CSRGraph& kr_GRAPH_, const vertex k_V_) const noexcept
+    {
+        for (std::size_t i{0}; i < mu_li_size; i++)
+        {
+            const vertex k_element = m_arr_nodes[i];
+
+            if (k_element == k_V_ || true == kr_GRAPH_.hasEdge(k_element, k_V_))
+            {
+                return false;
+            } // end if
+        } // end for i
+
+        return true;
+    } // end method is_exclusive
+
+
+    /** @brief Runs the stack of frames until the bottom frame is done.*/
+    template <typename T>
+    void walk(const CSRGraph& kr_GRAPH_, T* p_subgraphs_, NautyLink& r_nautylink_, ESUSplitter* p_splitter_)
+    {
+        const vertex k_root = m_arr_nodes[0];
+        const std::size_t ku_li_order = order();
+        std::size_t u_li_steps{0};
+
+        while (mu_li_depth > 0)
+        {
+            if (nullptr != p_splitter_ && 0 == (++u_li_steps & (ku_li_SPLIT_POLL - 1)) && true == p_splitter_->hungry())
+            {
+                split(p_splitter_);
+            } // end if
+
+            const Frame k_frame = m_arr_frames[mu_li_depth - 1];
+
+            // one vertex short of a leaf, every vertex of the extension
+            // completes one
+            if (mu_li_size + 1 == ku_li_order)
+            {
+                for (std::size_t i{k_frame.u_li_cursor}; i < k_frame.u_li_stop; i++)
+                {
+                    if (true == should_extend(md_leaf_prob))
+                    {
+                        add_leaf<T>(kr_GRAPH_, m_vect_extension[i], p_subgraphs_, r_nautylink_);
+                    } // end if
+                } // end for i
+
+                pop_frame();
+                continue;
+            } // end if
+
+            if (k_frame.u_li_cursor == k_frame.u_li_stop)
+            {
+                pop_frame();
+                continue;
+            } // end if
+
+            const vertex k_w = m_vect_extension[k_frame.u_li_cursor];
+            m_arr_frames[mu_li_depth - 1].u_li_cursor++;
+
+            // the next level extends what is left of this one with the
+            // neighbors of w that are new to the subgraph
+            const std::size_t ku_li_begin = m_vect_extension.size();
+            const std::size_t ku_li_left = k_frame.u_li_end - k_frame.u_li_cursor - 1;
+
+            m_vect_extension.resize(ku_li_begin + ku_li_left);
+
+            std::copy(m_vect_extension.begin() + static_cast<std::ptrdiff_t>(k_frame.u_li_cursor + 1),
+                      m_vect_extension.begin() + static_cast<std::ptrdiff_t>(k_frame.u_li_end),
+                      m_vect_extension.begin() + static_cast<std::ptrdiff_t>(ku_li_begin));
+
+            for (const vertex u : kr_GRAPH_.getAdjacencyList(k_w).above(k_root))
+            {
+                if (true == is_exclusive(kr_GRAPH_, u))
+                {
+                    m_vect_extension.push_back(u);
+                } // end if
+            } // end for u
+
+            const std::size_t ku_li_size = mu_li_size;
+            m_arr_nodes[mu_li_size++] = k_w;
+
+            if (true == should_extend(m_arr_probs[ku_li_size]))
+            {
+                m_arr_frames[mu_li_depth++] = Frame{ku_li_begin, ku_li_begin, m_vect_extension.size(), m_vect_extension.size()};
+            } // end if
+            else
+            {
+                m_vect_extension.resize(ku_li_begin);
+                mu_li_size--;
+            } // end else
+        } // end while
+    } // end method walk
+
+
+    /** @brief Gives the back half of what is left of the shallowest frame
+      *        of a small node to the splitter, if one has anything left.
+      * @remark Only nodes whose children aren't leaves are split, a leaf
+      *         frame is done in a single step anyway.
+      */
+    void split(ESUSplitter* p_splitter_)
+    {
+        const std::size_t ku_li_order = order();
+
+        for (std::size_t i{0}; i < mu_li_depth; i++)
+        {
+            const std::size_t ku_li_size = mu_li_base + i;
+
+            if (ku_li_size > ku_li_SPLIT_MAX_SIZE || ku_li_size + 1 >= ku_li_order)
+            {
+                break;
+            } // end if
+
+            Frame& r_frame = m_arr_frames[i];
+
+            if (r_frame.u_li_cursor == r_frame.u_li_stop)
+            {
+                continue;
+            } // end if
+
+            const std::size_t ku_li_split = r_frame.u_li_stop - (r_frame.u_li_stop - r_frame.u_li_cursor + 1) / 2;
+
+            ESUSubtree subtree;
+            subtree.m_vect_nodes.assign(m_arr_nodes.begin(), m_arr_nodes.begin() + static_cast<std::ptrdiff_t>(ku_li_size));
+            subtree.m_vect_extension.assign(m_vect_extension.begin() + static_cast<std::ptrdiff_t>(ku_li_split),
+                                            m_vect_extension.begin() + static_cast<std::ptrdiff_t>(r_frame.u_li_end));
+            subtree.mu_li_count = r_frame.u_li_stop - ku_li_split;
+
+            r_frame.u_li_stop = ku_li_split;
+
+            p_splitter_->publish(std::move(subtree));
+            return;
+        } // end for i
+    } // end method split
+
+
+    /** @brief Drops the top frame, its extension and its vertex.*/
+    void pop_frame(void) noexcept
+    {
+        m_vect_extension.resize(m_arr_frames[--mu_li_depth].u_li_begin);
+        mu_li_size--;
+    } // end method pop_frame
+
+
+    /** @brief Copies the subgraph plus one vertex into the next leaf.*/
+    template <typename T>
+    void add_leaf(const CSRGraph& kr_GRAPH_, const vertex k_V_, T* p_subgraphs_, NautyLink& r_nautylink_)
+    {
+        const std::size_t ku_li_order = order();
+
+        m_vect_leaves.emplace_back(ku_li_order);
+        m_vect_leaves.back().assign(m_arr_nodes.data(), ku_li_order - 1);
+        m_vect_leaves.back().add(k_V_);
+
+        if (m_vect_leaves.size() == ku_li_LEAF_BATCH_SIZE)
+        {
+            flush<T>(kr_GRAPH_, p_subgraphs_, r_nautylink_);
+        } // end if
+    } // end method add_leaf
+
+
+    /** @brief Labels the buffered leaves in the numbering of the Graph and
+      *        adds them to the result.
+      */
+    template <typename T>
+    void flush(const CSRGraph& kr_GRAPH_, T* p_subgraphs_, NautyLink& r_nautylink_)
+    {
+        for (InlineSubgraph& r_leaf : m_vect_leaves)
+        {
+            kr_GRAPH_.restore(r_leaf);
+        } // end for r_leaf
+
+        p_subgraphs_->add_batch(m_vect_leaves, r_nautylink_);
+
+        // the leaves are trivially destructible, clearing keeps the storage
+        m_vect_leaves.clear();
+    } // end method flush
+
+    //! the motif size when K is 0
+    std::size_t mu_li_order = K;
+
+    //! the vertices of the current node of the tree
+    Slots<vertex> m_arr_nodes{};
+    //! number of vertices in the current node
+    std::size_t mu_li_size = 0;
+    //! the extensions of all levels, back to back
+    std::vector<vertex> m_vect_extension;
+    //! one frame per level below the current node
+    Slots<Frame> m_arr_frames{};
+    //! number of frames on the stack
+    std::size_t mu_li_depth = 0;
+    //! number of vertices of the node of the bottom frame
+    std::size_t mu_li_base = 1;
+    //! the probability of descending to every level
+    Slots<double> m_arr_probs{};
+    //! the probability of keeping a leaf
+    double md_leaf_prob = 1.0;
+
+    //! the leaves waiting to be labeled
+    std::vector<InlineSubgraph> m_vect_leaves;
+}; // end class ESUEngine
+
+
+/** @brief Calls the function with the engine of the calling thread that is
+  *        compiled for the motif size, ESUEngine<0> for sizes without one.
+  */
+template <typename F>
+void with_esu_engine(const std::size_t ku_li_ORDER_, F&& r_function_)
+{
+    switch (ku_li_ORDER_)
+    {
+        case 3:  r_function_(ESUEngine<3>::instance());  break;
+        case 4:  r_function_(ESUEngine<4>::instance());  break;
+        case 5:  r_function_(ESUEngine<5>::instance());  break;
+        case 6:  r_function_(ESUEngine<6>::instance());  break;
+        case 7:  r_function_(ESUEngine<7>::instance());  break;
+        case 8:  r_function_(ESUEngine<8>::instance());  break;
+        case 9:  r_function_(ESUEngine<9>::instance());  break;
+        case 10: r_function_(ESUEngine<10>::instance()); break;
+        default: r_function_(ESUEngine<0>::instance());  break;
+    } // end switch
+} // end method with_esu_engine
+
+#endif // !__ESU_ENGINE_HPP
@@ -0,0 +1,145 @@
+#pragma once
+
+#ifndef __ESU_SPLITTER_HPP
+#define __ESU_SPLITTER_HPP
+
+#include <atomic>             // atomic
+#include <cstddef>            // size_t
+#include <functional>         // function
+#include <mutex>              // mutex, unique_lock, lock_guard
+#include <condition_variable> // condition_variable
+#include <vector>             // vector
+#include <utility>            // move
+
+#include "Config.hpp"
+#include "graph64.hpp" // vertex
+
+
+/** @brief The part of an ESU tree left below a node, split off so that
+  *        another worker can walk it.
+  */
+struct ESUSubtree
+{
+    //! the vertices of the node, root first, numbered as in the snapshot
+    std::vector<vertex> m_vect_nodes;
+    //! the extension of the node, each entry's child extends the entries after it
+    std::vector<vertex> m_vect_extension;
+    //! number of leading entries of the extension whose children belong to the subtree
+    std::size_t mu_li_count = 0;
+}; // end struct ESUSubtree
+
+
+/** @brief Lets the workers of a parallel enumeration hand shallow subtrees
+  *        to each other.
+  * @remark One job per root leaves the pool idle while a few hub roots run
+  *         on. An engine walking a root asks hungry() now and then, and
+  *         while fewer jobs are queued than there are workers it publishes
+  *         half of what is left at one of the two top levels of its tree.
+  *         The splitter counts every job from queuing to its end, so wait()
+  *         also covers the subtrees published after the roots.
+  */
+class ESUSplitter
+{
+public:
+    //! passes a subtree on to the pool
+    using publish_t = std::function<void(ESUSubtree&&)>;
+
+
+    /** @brief A splitter for the given number of workers.
+      * @param fn_publish_ Queues a job walking the subtree it is given,
+      *        called by the workers, so it must not block.
+      */
+    ESUSplitter(const std::size_t ku_li_WORKERS_, publish_t fn_publish_)
+     : mu_li_workers(ku_li_WORKERS_), m_fn_publish(std::move(fn_publish_))
+    {
+    } // end Constructor
+
+    ESUSplitter(const ESUSplitter&) = delete;
+    ESUSplitter& operator=(const ESUSplitter&) = delete;
+
+
+    /** @brief Counts a job from the moment it is queued until it ends.*/
+    class Job
+    {
+    public:
+        explicit Job(ESUSplitter& r_splitter_) noexcept
+         : mr_splitter(r_splitter_)
+        {
+            mr_splitter.mu_li_queued.fetch_sub(1, std::memory_order_relaxed);
+        } // end Constructor
+
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        ~Job(void)
+        {
+            mr_splitter.finished();
+        } // end Destructor
+
+    private:
+        ESUSplitter& mr_splitter;
+    }; // end class Job
+
+
+    /** @brief Whether fewer jobs are waiting than there are workers.*/
+    bool hungry(void) const noexcept
+    {
+        return mu_li_queued.load(std::memory_order_relaxed) < mu_li_workers;
+    } // end method hungry
+
+
+    /** @brief Counts a job about to be queued, a Job created when it runs
+      *        balances the count.
+      */
+    void queued(void) noexcept
+    {
+        mu_li_queued.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(m_mtx);
+        mu_li_outstanding++;
+    } // end method queued
+
+
+    /** @brief Queues a job walking the subtree.*/
+    void publish(ESUSubtree&& r_subtree_)
+    {
+        queued();
+        m_fn_publish(std::move(r_subtree_));
+    } // end method publish
+
+
+    /** @brief Blocks until every job queued has ended.*/
+    void wait(void)
+    {
+        std::unique_lock<std::mutex> lock(m_mtx);
+        m_cv.wait(lock, [this]{ return 0 == mu_li_outstanding; });
+    } // end method wait
+
+private:
+    /** @brief Ends a job, waking wait() after the last one.*/
+    void finished(void)
+    {
+        std::lock_guard<std::mutex> guard(m_mtx);
+
+        if (0 == --mu_li_outstanding)
+        {
+            m_cv.notify_all();
+        } // end if
+    } // end method finished
+
+    //! number of workers of the pool
+    const std::size_t mu_li_workers;
+    //! queues the job of a subtree
+    publish_t m_fn_publish;
+
+    //! jobs queued that haven't started
+    std::atomic<std::size_t> mu_li_queued{0};
+    //! jobs queued that haven't ended
+    std::size_t mu_li_outstanding = 0;
+    //! protects mu_li_outstanding
+    std::mutex m_mtx;
+    //! signaled when the last job ends
+    std::condition_variable m_cv;
+}; // end class ESUSplitter
+
+#endif // !__ESU_SPLITTER_HPP
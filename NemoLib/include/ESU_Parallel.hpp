@@ -16,10 +16,15 @@
 #include "Config.hpp"
 #include "Utility.hpp"
 #include "RandESU.hpp"
+#include "ESUSplitter.hpp"	// ESUSplitter, ESUSubtree
 #include "ThreadPool.hpp"	// ThreadPool
 #include "SubgraphCount.hpp"
 #include <functional>
 #include <chrono>
+#include <memory>			// make_shared
+#include <vector>			// vector
+#include <cstdint>			// uint64_t
+#include <algorithm>		// stable_sort, max
 
 #include "loguru.hpp"       // DLOG_F, LOG_F
 
@@ -30,7 +35,102 @@
    */
 namespace ESU_Parallel
 {
+	//! a job walks the trees of at most this many roots
 	static constexpr std::size_t BATCH_SIZE = 10000;
+	//! the roots are split into about this many jobs per thread
+	static constexpr std::size_t CHUNKS_PER_THREAD = 32;
+
+
+	/**
+	  * Consecutive roots whose trees are walked by one job.
+	  */
+	struct RootChunk
+	{
+		vertex begin;        // the first root
+		vertex end;          // one past the last root
+		std::uint64_t cost;  // the estimated cost of all the trees
+	};
+
+
+	/**
+	  * Estimates the size of the ESU tree of a root from its first two
+	  * levels: the pairs of its extension and the neighbors of every vertex
+	  * in it.
+	  */
+	static std::uint64_t estimate_cost(const CSRGraph& csr, vertex root)
+	{
+		const CSRGraph::NeighborRange extension = csr.getAdjacencyList(root).above(root);
+		std::uint64_t cost = 1 + static_cast<std::uint64_t>(extension.size()) * extension.size();
+
+		for (const vertex u : extension)
+		{
+			cost += csr.degree(u);
+		} // end for u
+
+		return cost;
+	} // end method estimate_cost
+
+
+	/**
+	  * Groups the roots into runs of consecutive vertices of about equal
+	  * estimated cost, the most expensive first. A root costing more than a
+	  * run is a run on its own, cheap roots share one, up to BATCH_SIZE. The
+	  * runs keep the order of the snapshot, so a job reads nearby vertices.
+	  *
+	  * @param n_threads the number of threads the runs are spread over
+	  */
+	static std::vector<RootChunk> plan_root_chunks(const CSRGraph& csr, std::size_t n_threads)
+	{
+		const std::size_t n_roots = csr.getSize();
+
+		std::vector<std::uint64_t> costs(n_roots);
+		std::uint64_t total = 0;
+
+		for (std::size_t i{0}; i < n_roots; i++)
+		{
+			costs[i] = estimate_cost(csr, static_cast<vertex>(i));
+			total += costs[i];
+		} // end for i
+
+		const std::uint64_t target = std::max<std::uint64_t>(1, total / (std::max<std::size_t>(1, n_threads) * CHUNKS_PER_THREAD));
+
+		std::vector<RootChunk> chunks;
+		RootChunk chunk{0, 0, 0};
+
+		for (std::size_t i{0}; i < n_roots; i++)
+		{
+			// an expensive root doesn't join the cheap ones before it
+			if (chunk.begin != chunk.end && chunk.cost + costs[i] > target)
+			{
+				chunks.push_back(chunk);
+				chunk = RootChunk{chunk.end, chunk.end, 0};
+			} // end if
+
+			chunk.end++;
+			chunk.cost += costs[i];
+
+			if (chunk.cost >= target || chunk.end - chunk.begin == BATCH_SIZE)
+			{
+				chunks.push_back(chunk);
+				chunk = RootChunk{chunk.end, chunk.end, 0};
+			} // end if
+		} // end for i
+
+		if (chunk.begin != chunk.end)
+		{
+			chunks.push_back(chunk);
+		} // end if
+
+		std::stable_sort(chunks.begin(), chunks.end(),
+			[](const RootChunk& lhs, const RootChunk& rhs)
+			{
+				return lhs.cost > rhs.cost;
+			} // end lambda
+		); // end stable_sort
+
+		return chunks;
+	} // end method plan_root_chunks
+
 
 	template <typename T>
 	static void accumulate_subgraphs(const std::vector<T>& vect_subgraphs, T* p_ser_subgraphs)
@@ -43,49 +143,99 @@ namespace ESU_Parallel
 
 
 	/**
-	  * Enumerates Subgraphs using the ESU algorithm. Requires user to specify
-	  * return type(s) and provide the accompanying data structures.
+	  * Enumerates Subgraphs of a snapshot, which may have been mapped from
+	  * a file, using the ESU algorithm.
 	  *
-	  * @param graph the graph on which to execute ESU
+	  * @param csr the CSR snapshot on which to execute ESU, shared by the
+	  *            workers
 	  * @param subgraphs the SubgraphEnumerationResult into which to enumerated
 	  *                  Subgraphs will be stored.
 	  * @param subgraphSize the size of the target Subgraphs
+	  * @remark The roots are walked in runs planned by plan_root_chunks,
+	  *         one job per run. While fewer jobs are queued than there are
+	  *         threads, the roots still running split the top levels of
+	  *         their trees into more jobs, so hub roots don't leave the
+	  *         other threads idle at the end.
 	  */
 	template <typename T>
-	static void enumerate(Graph& graph, T* subgraphs, int subgraphSize, ThreadPool* my_pool, const std::string& labelg_path)
+	static void enumerate(const CSRGraph& csr, T* subgraphs, int subgraphSize, ThreadPool* my_pool, const LabelGOptions& labelg_options)
 	{
         DLOG_F(DEBUG_LEVEL, "In ESU_Parallel::enumerate");
 
-		NautyLink nautylink(labelg_path, subgraphSize, graph.getEdges(), graph.isDirected());
-
-		auto n_jobs = graph.getSize();
+		NautyLink nautylink(labelg_options, subgraphSize, csr);
 
 		my_pool->Start_All_Threads();
 
-		// process the batch's data
-		for (std::size_t i{0}; i < n_jobs; i++)
-		{
-			if (0 == i % 10000)
+		// split off subtrees are queued by the workers, so they must not
+		// wait for room in the queue
+		ESUSplitter splitter(my_pool->N_Threads_Running(),
+			[&csr, &subgraphs, subgraphSize, &nautylink, &splitter, my_pool](ESUSubtree&& subtree)
 			{
-                LOG_F(INFO, "Creating job %zu / %zu", i+1, n_jobs);
-			}
+				auto p_subtree = std::make_shared<ESUSubtree>(std::move(subtree));
+
+				my_pool->Add_Job_Force(
+					[&csr, &subgraphs, subgraphSize, &nautylink, &splitter, p_subtree](void)
+					{
+						ESUSplitter::Job job(splitter);
+						const std::vector<double> probs(subgraphSize, 1.0);
+						RandESU::enumerate<T>(csr, subgraphs, subgraphSize, probs, *p_subtree, nautylink, &splitter);
+					} // end lambda
+				); // end Add_Job_Force
+			} // end lambda
+		);
+
+		const std::vector<RootChunk> chunks = plan_root_chunks(csr, my_pool->N_Threads_Running());
+
+        LOG_F(INFO, "Creating %zu jobs for %zu roots", chunks.size(), csr.getSize());
+
+		// the most expensive runs go first
+		for (const RootChunk& chunk : chunks)
+		{
+			splitter.queued();
 
 			my_pool->Add_Job(
-				[&graph, &subgraphs, i, subgraphSize, &nautylink](void)
+				[&csr, &subgraphs, chunk, subgraphSize, &nautylink, &splitter](void)
 				{
+					ESUSplitter::Job job(splitter);
 					const std::vector<double> probs(subgraphSize, 1.0);
-					Graph& my_graph = graph;
+					const CSRGraph& my_graph = csr;
 					T* my_result = subgraphs;
 					NautyLink& my_link = nautylink;
-					RandESU::enumerate<T>(my_graph, my_result, subgraphSize, probs, static_cast<vertex>(i), my_link);
+
+					for (vertex v = chunk.begin; v < chunk.end; v++)
+					{
+						RandESU::enumerate<T>(my_graph, my_result, subgraphSize, probs, v, my_link, &splitter);
+					} // end for v
 				} // end lambda
 			); // end Add_Job
-		} // end for i
+		} // end for chunk
 
         LOG_F(INFO, "Waiting for enumeration to finish ...");
 
+		// the pool may look idle between a split and the job it queues
+		splitter.wait();
 		my_pool->Synchronize();
 
         LOG_F(INFO, "Enumeration done");
 	} // end method enumerate
+
+
+	/**
+	  * Enumerates Subgraphs using the ESU algorithm. Requires user to specify
+	  * return type(s) and provide the accompanying data structures.
+	  *
+	  * @param graph the graph on which to execute ESU
+	  * @param subgraphs the SubgraphEnumerationResult into which to enumerated
+	  *                  Subgraphs will be stored.
+	  * @param subgraphSize the size of the target Subgraphs
+	  * @param csr_options how to lay out the graph for enumerating
+	  */
+	template <typename T>
+	static void enumerate(Graph& graph, T* subgraphs, int subgraphSize, ThreadPool* my_pool, const LabelGOptions& labelg_options, const CSROptions& csr_options = CSROptions{})
+	{
+		// the workers share one read-only snapshot
+		const CSRGraph csr(graph, csr_options);
+
+		enumerate<T>(csr, subgraphs, subgraphSize, my_pool, labelg_options);
+	} // end method enumerate
 };
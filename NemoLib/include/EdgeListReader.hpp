@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef __EDGE_LIST_READER_HPP
+#define __EDGE_LIST_READER_HPP
+
+#include <vector>   // vector
+#include <string>   // string
+#include <utility>  // pair
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+#include "graph64.hpp" // vertex
+
+
+/** @brief How the vertex names of a text edge list are read.*/
+enum class VertexIds
+{
+    //! as integers if every name is one, otherwise as strings
+    AUTO,
+    //! as integers, any other name is an error
+    NUMERIC,
+    //! as strings
+    NAMES
+}; // end enum VertexIds
+
+
+/** @brief Parses "auto", "numeric" or "names".
+  * @throws std::invalid_argument For any other name.
+  */
+VertexIds parse_vertex_ids(const std::string& kr_str_NAME_);
+
+
+/** @brief How a text edge list is read.*/
+struct ParseOptions
+{
+    ParseOptions(const std::size_t ku_li_THREADS_ = 0, const bool kb_SHUFFLE_ = true, const std::uint64_t ku_SEED_ = 0, const VertexIds k_IDS_ = VertexIds::AUTO)
+     : mu_li_threads(ku_li_THREADS_), m_b_shuffle(kb_SHUFFLE_), mu_seed(ku_SEED_), m_ids(k_IDS_)
+    {}
+
+    //! threads to tokenize with, 0 for one per core
+    std::size_t mu_li_threads;
+    //! whether vertices are numbered in the order they first appear in a
+    //! shuffle of the edges, rather than in the order of the file, text
+    //! edge lists only
+    bool m_b_shuffle;
+    //! seed of the shuffle, 0 to draw one from RNG_provider
+    std::uint64_t mu_seed;
+    //! whether the names are integers
+    VertexIds m_ids;
+}; // end struct ParseOptions
+
+
+/** @brief Parses "on", "off" or a seed for the shuffle of a ParseOptions.
+  * @throws std::invalid_argument For anything else.
+  */
+void parse_shuffle(const std::string& kr_str_MODE_, ParseOptions& r_options_);
+
+
+/** @brief The edges of a graph file, with its vertices numbered densely.*/
+struct EdgeList
+{
+    //! whether the edges go from their first vertex to their second
+    bool m_b_directed = false;
+    //! number of vertices
+    std::size_t mu_li_vertices = 0;
+    //! name of every vertex, by number, empty if the names were integers
+    //! or the file numbers the vertices itself
+    std::vector<std::string> m_vect_names;
+    //! integer name of every vertex, by number, empty unless the names
+    //! were integers
+    std::vector<std::uint64_t> m_vect_ids;
+    //! the edges as they were read, without self edges, repeats are kept
+    std::vector<std::pair<vertex, vertex>> m_vect_edges;
+}; // end struct EdgeList
+
+
+/** @brief The name of every vertex of an edge list, integer names written
+  *        out in decimal, empty if the file numbers the vertices itself.
+  */
+std::vector<std::string> vertex_names(const EdgeList& kr_EDGES_);
+
+
+/** @brief Reads a whitespace separated edge list, one edge per line, or a
+  *        graph6, sparse6 or digraph6 file.
+  * @param kr_str_PATH_ The file to read
+  * @param kb_DIRECTED_ Whether each line is an edge from its first vertex to
+  *        its second, graph6 and sparse6 files are always undirected and
+  *        digraph6 files always directed
+  * @throws std::invalid_argument If the file can't be opened, or is a
+  *         truncated, incremental or multi-graph graph6 family file.
+  * @remark The file is memory-mapped and split into one chunk per thread at
+  *         line boundaries. Each thread tokenizes its chunk and numbers the
+  *         names it sees locally, then the names are merged through a map
+  *         sharded by hash, one shard per thread. The first appearance of
+  *         every name decides its number, so the numbering is the same
+  *         whatever the number of threads. Lines with fewer than two
+  *         tokens are skipped and tokens past the second are ignored.
+  *         Names that are all plain decimal integers skip the name maps,
+  *         they are parsed in place and numbered through a flat array
+  *         indexed by the integer, or by its rank among the radix sorted
+  *         integers if they are too sparse for one. A leading zero makes a
+  *         name a string, so "07" and "7" stay two vertices.
+  *         A file whose first line is a single graph6 family string, with
+  *         or without its >>graph6<< style header, is decoded bit by bit
+  *         straight from the mapping instead. Its vertices keep the numbers
+  *         of the file, so it has no names and is never shuffled.
+  */
+EdgeList read_edge_list(const std::string& kr_str_PATH_, const bool kb_DIRECTED_, const ParseOptions& kr_OPTIONS_ = ParseOptions{});
+
+#endif // !__EDGE_LIST_READER_HPP
@@ -20,6 +20,7 @@
 #include <unordered_set>	// unordered_set 
 #include <unordered_map>	// unordered_map
 #include "graph64.hpp"		// vertex, edgetype
+#include "EdgeListReader.hpp"	// EdgeList, ParseOptions
 
 
 class Graph 
@@ -35,12 +36,18 @@ public:
 	}
 
 
-	Graph(const std::string& filename, const bool dir = false) : directed(dir)
+	Graph(const std::string& filename, const bool dir = false, const ParseOptions& options = ParseOptions{}) : directed(dir)
 	{ 
-		parse(filename); 
+		parse(filename, options); 
 	};
 
 
+	explicit Graph(const EdgeList& edgeList) : directed(edgeList.m_b_directed)
+	{
+		assign(edgeList);
+	}
+
+
 	Graph(const Graph& OTHER) 
 	{
 		*this = OTHER; 
@@ -57,8 +64,11 @@ public:
 	{
 		directed = OTHER.directed;
 		adjacencyLists = std::vector<std::unordered_set<vertex>>(OTHER.adjacencyLists);
+		outAdjacencyLists = OTHER.outAdjacencyLists;
+		inAdjacencyLists = OTHER.inAdjacencyLists;
 		name2Index = std::unordered_map<std::string, vertex>(OTHER.name2Index);
-		edges = std::unordered_map<edge, edgetype>(OTHER.edges);
+		index2Name = OTHER.index2Name;
+		edgeCount = OTHER.edgeCount;
 		return *this;
 	}
 
@@ -67,8 +77,11 @@ public:
 	{
 		directed = other.directed;
 		adjacencyLists = std::move(other.adjacencyLists);
+		outAdjacencyLists = std::move(other.outAdjacencyLists);
+		inAdjacencyLists = std::move(other.inAdjacencyLists);
 		name2Index = std::move(other.name2Index);
-		edges = std::move(other.edges);
+		index2Name = std::move(other.index2Name);
+		edgeCount = other.edgeCount;
 		return *this;
 	}
 
@@ -88,33 +101,43 @@ public:
 	} // end method 
 
 
+	// heads of the edges leaving a vertex, only kept for directed graphs
+	inline auto& getOutAdjacencyList(vertex index) const
+	{
+		return outAdjacencyLists.at(index);
+	} // end method 
+
+
+	// tails of the edges entering a vertex, only kept for directed graphs
+	inline auto& getInAdjacencyList(vertex index) const
+	{
+		return inAdjacencyLists.at(index);
+	} // end method 
+
+
 	inline auto& getNametoIndex() const noexcept
 	{
 		return name2Index;
 	} // end method 
 
 
-	inline auto getIndextoName() const noexcept // will be useful if need to match the index to name
+	// name of every vertex by index, empty for vertices added without one
+	inline auto& getIndextoName() const noexcept
 	{
-		std::unordered_map<vertex, std::string> Index2name;
-		for (auto v : name2Index)
-		{
-			Index2name[v.second] = v.first;
-		}
-
-		return Index2name;
+		return index2Name;
 	} // end method 
 
 
-	inline auto& getEdges() const // added by following the original ESU program
+	// number of connected vertex pairs, a pair connected both ways counts once
+	inline std::size_t getEdgeCount() const noexcept
 	{
-		return edges;
+		return edgeCount;
 	} // end method 
 
 
 	inline std::size_t addVertex() noexcept
 	{
-		adjacencyLists.push_back(std::unordered_set<vertex>());
+		pushVertex();
 		return adjacencyLists.size() - 1;
 	}
 
@@ -124,14 +147,13 @@ public:
 		adjacencyLists.reserve(adjacencyLists.size() + n);
 		for (std::size_t i{0}; i < n; i++)
 		{
-			adjacencyLists.push_back(std::unordered_set<vertex>());
+			pushVertex();
 		}
 	}
 
 
 	inline void addEdges(const std::vector<int> EDGES)
 	{
-		edges.reserve(edges.size() + (EDGES.size() / 2));
 		for (std::size_t i{0}; i < EDGES.size(); i += 2)
 		{
 			addEdge(EDGES[i], EDGES[i + 1]);
@@ -179,13 +201,32 @@ public:
 	friend std::ostream& operator<< (std::ostream&, const Graph&);
 
 private:
+	// the underlying undirected structure, which is what ESU enumerates
 	std::vector<std::unordered_set<vertex>> adjacencyLists;
+	// the direction of every edge for directed graphs, empty otherwise
+	std::vector<std::vector<vertex>> outAdjacencyLists;
+	std::vector<std::vector<vertex>> inAdjacencyLists;
 	std::unordered_map<std::string, vertex> name2Index;
-	std::unordered_map<edge, edgetype> edges;
+	std::vector<std::string> index2Name;
+	std::size_t edgeCount = 0;
 
 	bool directed;
 
-	void parse(const std::string&);
+	void parse(const std::string&, const ParseOptions&);
+	void assign(const EdgeList&);
+	void connect(vertex, vertex);
+
+	inline void pushVertex()
+	{
+		adjacencyLists.push_back(std::unordered_set<vertex>());
+		index2Name.emplace_back();
+
+		if (directed)
+		{
+			outAdjacencyLists.push_back(std::vector<vertex>());
+			inAdjacencyLists.push_back(std::vector<vertex>());
+		}
+	}
 	vertex getOrCreateIndex(const std::string&, std::unordered_map<std::string, vertex>&);
 };
 
@@ -0,0 +1,175 @@
+#pragma once
+
+#ifndef __INLINE_SUBGRAPH_HPP
+#define __INLINE_SUBGRAPH_HPP
+
+#include <array>       // array
+#include <string>      // string, to_string
+#include <cstdint>     // uint8_t
+#include <cstddef>     // size_t
+#include <algorithm>   // copy_n, find
+#include <stdexcept>   // invalid_argument
+#include <type_traits> // is_trivially_copyable
+
+#include "Config.hpp"
+#include "graph64.hpp"   // vertex
+#include "Subgraph.hpp"  // Subgraph
+
+
+/** @brief A subgraph whose vertices are stored inline.
+  * @remark The hot paths copy subgraphs by the thousand and keep every one
+  *         a collection reports, so this type has no heap storage and no
+  *         vtable and is copied with a memcpy. It has the API of Subgraph
+  *         and converts to and from it where results take the legacy class.
+  */
+class InlineSubgraph
+{
+public:
+    //! the most vertices a subgraph can hold, motif codes stop well before
+    static constexpr std::size_t ku_li_CAPACITY = 16;
+
+
+    /** @brief An empty subgraph of the given intended size.
+      * @throws std::invalid_argument If the size is over ku_li_CAPACITY.
+      */
+    explicit InlineSubgraph(const std::size_t ku_li_ORDER_ = 0)
+     : mu8_order(static_cast<std::uint8_t>(ku_li_ORDER_))
+    {
+        if (ku_li_ORDER_ > ku_li_CAPACITY)
+        {
+            throw std::invalid_argument("Subgraphs of size " + std::to_string(ku_li_ORDER_) + " don't fit inline, the most is " + std::to_string(ku_li_CAPACITY));
+        } // end if
+    } // end Constructor
+
+
+    /** @brief A copy of the vertices of a legacy subgraph.*/
+    explicit InlineSubgraph(const Subgraph& kr_SUBGRAPH_)
+     : InlineSubgraph(kr_SUBGRAPH_.getOrder())
+    {
+        assign(kr_SUBGRAPH_.data(), kr_SUBGRAPH_.getSize());
+    } // end Constructor
+
+
+    /** @brief A legacy subgraph with the same vertices.*/
+    explicit operator Subgraph(void) const
+    {
+        Subgraph subgraph(mu8_order);
+
+        for (std::size_t i{0}; i < mu8_size; i++)
+        {
+            subgraph.add(m_arr_nodes[i]);
+        } // end for i
+
+        return subgraph;
+    } // end method operator Subgraph
+
+
+    /** @brief The vertices as "[v0,v1,...]", as Subgraph writes them.*/
+    explicit operator std::string(void) const
+    {
+        if (0 == mu8_size)
+        {
+            return "empty";
+        } // end if
+
+        std::string str_out{"["};
+
+        for (std::size_t i{0}; i < mu8_size; i++)
+        {
+            str_out += std::to_string(m_arr_nodes[i]);
+            str_out += (i + 1 < mu8_size ? ',' : ']');
+        } // end for i
+
+        return str_out;
+    } // end method operator std::string
+
+
+    const vertex* begin(void) const noexcept { return m_arr_nodes.data(); }
+    const vertex* end(void) const noexcept { return m_arr_nodes.data() + mu8_size; }
+
+    vertex* begin(void) noexcept { return m_arr_nodes.data(); }
+    vertex* end(void) noexcept { return m_arr_nodes.data() + mu8_size; }
+
+    const vertex* data(void) const noexcept { return m_arr_nodes.data(); }
+
+
+    /** @brief Adds the next vertex, precondition: not complete.*/
+    void add(const vertex k_V_) noexcept
+    {
+        m_arr_nodes[mu8_size++] = k_V_;
+    } // end method add
+
+
+    /** @brief Replaces the vertices with the given ones, precondition:
+      *        count <= getOrder().
+      */
+    void assign(const vertex* kp_NODES_, const std::size_t ku_li_COUNT_) noexcept
+    {
+        std::copy_n(kp_NODES_, ku_li_COUNT_, m_arr_nodes.begin());
+        mu8_size = static_cast<std::uint8_t>(ku_li_COUNT_);
+    } // end method assign
+
+
+    /** @brief Removes the last vertex added.*/
+    void pop(void) noexcept
+    {
+        mu8_size--;
+    } // end method pop
+
+
+    /** @brief Removes every vertex.*/
+    void clear(void) noexcept
+    {
+        mu8_size = 0;
+    } // end method clear
+
+
+    vertex get(const std::size_t ku_li_N_) const noexcept
+    {
+        return m_arr_nodes[ku_li_N_];
+    } // end method get
+
+
+    /** @brief The first vertex added.*/
+    vertex root(void) const noexcept
+    {
+        return m_arr_nodes[0];
+    } // end method root
+
+
+    bool isComplete(void) const noexcept
+    {
+        return mu8_size == mu8_order;
+    } // end method isComplete
+
+
+    std::size_t getOrder(void) const noexcept
+    {
+        return mu8_order;
+    } // end method getOrder
+
+
+    std::size_t getSize(void) const noexcept
+    {
+        return mu8_size;
+    } // end method getSize
+
+
+    bool contains(const vertex k_V_) const noexcept
+    {
+        return end() != std::find(begin(), end(), k_V_);
+    } // end method contains
+
+private:
+    //! the vertices, slots past the size are stale
+    std::array<vertex, ku_li_CAPACITY> m_arr_nodes;
+    //! the intended size
+    std::uint8_t mu8_order;
+    //! number of vertices added
+    std::uint8_t mu8_size = 0;
+}; // end class InlineSubgraph
+
+
+static_assert(std::is_trivially_copyable<InlineSubgraph>::value, "InlineSubgraph must copy with a memcpy");
+
+#endif // !__INLINE_SUBGRAPH_HPP
@@ -0,0 +1,171 @@
+#pragma once
+
+#ifndef __LABEL_CACHE_HPP
+#define __LABEL_CACHE_HPP
+
+#include <array>         // array
+#include <cstddef>       // size_t
+#include <shared_mutex>  // shared_mutex, shared_lock
+#include <mutex>         // unique_lock
+#include <unordered_map> // unordered_map
+#include <string>        // string
+#include <vector>        // vector
+#include <utility>       // pair
+
+#include "MotifCode.hpp" // MotifCode
+
+
+/** @brief Process-wide memoization table mapping raw motif codes to their
+  *        cannonical codes.
+  * @remark Every NautyLink shares the same instance, so motif classes
+  *         labeled while enumerating the target graph are hits for all
+  *         random graphs. Lookups vastly outnumber inserts, so the table is
+  *         split into shards guarded by reader-writer locks to keep readers
+  *         from contending. The table can be loaded from and saved to a
+  *         binary file so that later runs start warm.
+  */
+class LabelCache
+{
+public:
+    //! number of independently locked shards, a power of two
+    static constexpr std::size_t ku_li_SHARDS = 64;
+
+
+    /** @brief Returns the instance shared by the whole process.*/
+    static LabelCache& instance(void)
+    {
+        static LabelCache s_cache;
+        return s_cache;
+    } // end method instance
+
+
+    /** @brief Looks up the cannonical code of a raw motif code.
+      * @param k_RAW_ The code of the subgraph as enumerated
+      * @param r_cannonical_ Receives the cannonical code on a hit
+      * @return Whether the code was found
+      */
+    bool find(const MotifCode k_RAW_, MotifCode& r_cannonical_) const
+    {
+        const Shard& kr_shard = shard_for(k_RAW_);
+        std::shared_lock guard(kr_shard.m_mtx);
+
+        auto it = kr_shard.m_umap_labels.find(k_RAW_);
+
+        if (it == kr_shard.m_umap_labels.end())
+        {
+            return false;
+        } // end if
+
+        r_cannonical_ = it->second;
+        return true;
+    } // end method find
+
+
+    /** @brief Stores the cannonical code of a raw motif code.
+      * @remark If two labelers race on the same code both compute the
+      *         same result, so the first insert simply wins.
+      */
+    void insert(const MotifCode k_RAW_, const MotifCode k_CANNONICAL_)
+    {
+        Shard& r_shard = shard_for(k_RAW_);
+        std::unique_lock guard(r_shard.m_mtx);
+
+        r_shard.m_umap_labels.emplace(k_RAW_, k_CANNONICAL_);
+    } // end method insert
+
+
+    /** @brief Number of memoized codes over all shards.*/
+    std::size_t size(void) const
+    {
+        std::size_t u_li_size{0};
+
+        for (const Shard& kr_shard : m_arr_shards)
+        {
+            std::shared_lock guard(kr_shard.m_mtx);
+            u_li_size += kr_shard.m_umap_labels.size();
+        } // end for kr_shard
+
+        return u_li_size;
+    } // end method size
+
+
+    /** @brief Drops every memoized code.*/
+    void clear(void)
+    {
+        for (Shard& r_shard : m_arr_shards)
+        {
+            std::unique_lock guard(r_shard.m_mtx);
+            r_shard.m_umap_labels.clear();
+        } // end for r_shard
+    } // end method clear
+
+
+    /** @brief Every memoized (raw, cannonical) pair, sorted by raw code.*/
+    std::vector<std::pair<MotifCode, MotifCode>> entries(void) const;
+
+
+    /** @brief Merges the codes stored in a cache file into the table.
+      * @param kr_str_PATH_ The cache file, @see save
+      * @param p_skipped_ Receives the number of entries skipped, if given
+      * @return false if the file doesn't exist
+      * @throws std::runtime_error If the file can't be read or is not a
+      *         label cache.
+      * @remark The file is memory-mapped, so a warm start costs little more
+      *         than inserting its entries. Entries whose codes disagree on
+      *         size or directedness are skipped. A labelg that answered
+      *         digraphs in graph6 left such entries for every directed
+      *         code, they are relabeled and dropped by the next save.
+      */
+    bool load(const std::string& kr_str_PATH_, std::size_t* p_skipped_ = nullptr);
+
+
+    /** @brief Writes the table, merged with the codes already in the file,
+      *        to a cache file.
+      * @param kr_str_PATH_ The cache file, created if missing
+      * @throws std::runtime_error If the file can't be written.
+      * @remark The file is a magic word, the number of entries and then
+      *         the (raw, cannonical) code pairs as native 64-bit integers.
+      *         Codes carry their size and directedness, so one file serves
+      *         every motif size. The file is written next to the target
+      *         and renamed over it, so concurrent runs never see a
+      *         partial file. Runs saving to the same file take turns on an
+      *         advisory lock of the file "<path>.lock", so none of them
+      *         renames its merge over entries another one just added.
+      */
+    void save(const std::string& kr_str_PATH_);
+
+private:
+    struct Shard
+    {
+        //! guards the labels of this shard
+        mutable std::shared_mutex m_mtx;
+        //! raw code to cannonical code
+        std::unordered_map<MotifCode, MotifCode> m_umap_labels;
+    }; // end struct Shard
+
+    LabelCache(void) = default;
+    LabelCache(const LabelCache&) = delete;
+    LabelCache& operator=(const LabelCache&) = delete;
+
+    // the low bits of a code are the first few vertex pairs,
+    // so they are mixed before picking a shard
+    static std::size_t shard_index(const MotifCode k_RAW_) noexcept
+    {
+        return static_cast<std::size_t>((k_RAW_ * 0x9E3779B97F4A7C15ull) >> 58) & (ku_li_SHARDS - 1);
+    } // end method shard_index
+
+    Shard& shard_for(const MotifCode k_RAW_)
+    {
+        return m_arr_shards[shard_index(k_RAW_)];
+    } // end method shard_for
+
+    const Shard& shard_for(const MotifCode k_RAW_) const
+    {
+        return m_arr_shards[shard_index(k_RAW_)];
+    } // end method shard_for
+
+    //! the shards, selected by the mixed code
+    std::array<Shard, ku_li_SHARDS> m_arr_shards;
+}; // end class LabelCache
+
+#endif // !__LABEL_CACHE_HPP
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef __LABEL_G_COPROCESS_HPP
+#define __LABEL_G_COPROCESS_HPP
+
+#include <string>        // string
+#include <stdio.h>       // FILE
+
+
+/** @brief A long-lived labelg process that labels one graph6 string per
+  *        line written to its stdin. Requires the patched labelg from
+  *        nauty26r12, which enters this mode when started without arguments.
+  * @remark The process is started with posix_spawn, so the implementation
+  *         is POSIX only and lives in LabelGCoprocess.cpp. Elsewhere
+  *         kb_SUPPORTED is false and LabelGProvider falls back to popen.
+  */
+class LabelGCoprocess
+{
+public:
+    //! whether coprocesses can be started on this platform
+#ifdef _WIN32
+    static constexpr bool kb_SUPPORTED = false;
+#else
+    static constexpr bool kb_SUPPORTED = true;
+#endif
+
+
+    LabelGCoprocess(void) = default;
+
+    // owns the pipes and the child process
+    LabelGCoprocess(const LabelGCoprocess&) = delete;
+    LabelGCoprocess& operator=(const LabelGCoprocess&) = delete;
+
+
+    /** @brief Closes the pipes which makes labelg exit, then reaps it.*/
+    ~LabelGCoprocess(void) noexcept;
+
+
+    /** @brief Starts labelg with its stdin and stdout connected to this object.
+      * @param kr_str_LABELG_PATH_ Path to the patched labelg program
+      * @throws std::runtime_error If the pipes or the process can't be
+      *         created, or coprocesses aren't supported.
+      */
+    void spawn(const std::string& kr_str_LABELG_PATH_);
+
+
+    /** @brief Sends one label to labelg and waits for its cannonical label.
+      * @param kr_str_LABEL_ The label to convert to a cannonical label
+      * @param str_cannonical_label Receives the cannonical label
+      * @return False if labelg is gone and no answer could be read.
+      */
+    bool label(const std::string& kr_str_LABEL_, std::string& str_cannonical_label);
+
+private:
+    //! process id of labelg
+    long ml_pid_child = 0;
+    //! write end of labelg's stdin
+    FILE* m_p_to_child = nullptr;
+    //! read end of labelg's stdout
+    FILE* m_p_from_child = nullptr;
+}; // end class LabelGCoprocess
+
+#endif // !__LABEL_G_COPROCESS_HPP
@@ -5,60 +5,150 @@
 #define __LABEL_G_PROVIDER_HPP
 
 #include <queue>         // queue
-#include <mutex>         // mutex, lock_guard
+#include <mutex>         // mutex, lock_guard, unique_lock
+#include <condition_variable> // condition_variable
+#include <atomic>        // atomic
+#include <unordered_map> // unordered_map
 #include <utility>       // pair
 #include <string>        // string
 #include <thread>        // thread
 #include <vector>        // vector
 #include <functional>    // function
-#include <unordered_map> // unordered_map
 #include <iostream>      // cerr
 #include <cstddef>       // size_t
+#include <memory>        // unique_ptr, make_unique, make_shared
+#include <algorithm>     // max
+#include <stdexcept>     // invalid_argument
 #include <stdio.h>       // FILE, popen, pclose, fgets
 
+#include "Config.hpp"    // _USE_NAUTY
+#include "NautyCanon.hpp"
+#include "LabelGCoprocess.hpp"
+
+
+/** @brief Selects how a LabelGProvider obtains cannonical labels.
+  * @remark Implicitly constructible from a labelg path so that existing
+  *         callers passing only a path keep the popen behaviour.
+  */
+struct LabelGOptions
+{
+    LabelGOptions(const std::string& kr_str_LABELG_PATH_ = "", const std::size_t ku_li_COPROCESSES_ = 0,
+                  const std::size_t ku_li_WORKERS_ = 0)
+     : m_str_labelg_path(kr_str_LABELG_PATH_), mu_li_coprocesses(ku_li_COPROCESSES_), mu_li_workers(ku_li_WORKERS_)
+    {}
+
+    LabelGOptions(const char* p_LABELG_PATH_)
+     : LabelGOptions(std::string{p_LABELG_PATH_})
+    {}
+
+    //! path to labelg, empty to label in-process with nauty
+    std::string m_str_labelg_path;
+
+    //! number of persistent labelg processes, 0 to popen labelg per label
+    std::size_t mu_li_coprocesses;
+
+    //! number of labeling workers, 0 for one per coprocess (at least one),
+    //! ignored when coprocesses are used as each worker owns one
+    std::size_t mu_li_workers;
+}; // end struct LabelGOptions
+
+
 class LabelGProvider
 {
 public:
     //! the callback type used to return the cannonical label
     using callback_t = std::function<void(std::string)>;
+    //! the callback type used to return the cannonical labels of a batch
+    using batch_callback_t = std::function<void(std::vector<std::string>)>;
 
 
-    /** @brief Terminates the worker and destroys the object.*/
+    /** @brief Terminates the workers and destroys the object.*/
     ~LabelGProvider(void) noexcept
     {
-        // inform thread to terminate
-        m_mtx_terminate.lock();
-        m_queue_terminate.push(true);
-        m_mtx_terminate.unlock();
+        // inform threads to terminate
+        m_b_terminate = true;
 
-        if (true == m_thread_worker.joinable())
+        for (auto& p_shard : m_vect_shards)
         {
-            m_thread_worker.join();
-        } // end if
+            // taking the lock orders the flag before a worker's
+            // wait, so the wakeup can't be missed
+            { // lock_guard scope
+                std::lock_guard guard(p_shard->m_mtx);
+            } // end lock_guard
+
+            p_shard->m_cv.notify_all();
+        } // end for p_shard
+
+        for (auto& worker : m_vect_workers)
+        {
+            if (true == worker.joinable())
+            {
+                worker.join();
+            } // end if
+        } // end for worker
     } // end Destructor
 
 
-    /** @brief Starts the worker thread.
-      * @param kr_str_LABELG_PATH_ Path to the labelg program 
+    /** @brief Starts the worker thread(s).
+      * @param kr_OPTIONS_ Path to the labelg program, if empty the labels
+      *        are computed in-process by nauty instead. If a number of
+      *        coprocesses is given, that many labelg processes are started
+      *        once, each served by its own worker thread. Otherwise, or
+      *        where coprocesses aren't supported, the requested number of
+      *        workers is started.
       * @remark This function should not be invoked multiple times 
       *         as this will cause threads to be overwritten.
+      * @throws std::invalid_argument If no labelg path is given but 
+      *         NemoLib was built without nauty.
+      * @throws std::runtime_error If a labelg coprocess can't be started.
       */
-    void start_up(const std::string& kr_str_LABELG_PATH_)
+    void start_up(const LabelGOptions& kr_OPTIONS_)
     {
-        m_str_labelg_path = kr_str_LABELG_PATH_;
+        m_str_labelg_path = kr_OPTIONS_.m_str_labelg_path;
+        m_b_in_process = m_str_labelg_path.empty();
+
+        #if !_USE_NAUTY
+            if (true == m_b_in_process)
+            {
+                throw std::invalid_argument("NemoLib was built without nauty, a path to labelg is required");
+            } // end if
+        #endif
 
         // if this is a call to start_up after a failure
-        // there will still be a failure signal in the queue
-        while (false == m_queue_terminate.empty())
+        // the failure signal is still raised
+        m_b_failed = false;
+        m_b_terminate = false;
+
+        m_vect_coprocesses.clear();
+
+        // without coprocesses the workers popen labelg for every label
+        if (false == m_b_in_process && true == LabelGCoprocess::kb_SUPPORTED)
         {
-            m_queue_terminate.pop();
+            for (std::size_t i{0}; i < kr_OPTIONS_.mu_li_coprocesses; i++)
+            {
+                m_vect_coprocesses.push_back(std::make_unique<LabelGCoprocess>());
+                m_vect_coprocesses.back()->spawn(m_str_labelg_path);
+            } // end for i
         } // end if
 
-        m_thread_worker = std::thread(
-            [this]{
-                this->loop();
-            }
-        );
+        const std::size_t ku_li_n_workers = false == m_vect_coprocesses.empty() ? m_vect_coprocesses.size() 
+                                          : std::max<std::size_t>(kr_OPTIONS_.mu_li_workers, 1);
+
+        m_vect_shards.clear();
+
+        for (std::size_t i{0}; i < ku_li_n_workers; i++)
+        {
+            m_vect_shards.push_back(std::make_unique<Shard>());
+        } // end for i
+
+        for (std::size_t i{0}; i < ku_li_n_workers; i++)
+        {
+            m_vect_workers.push_back(std::thread(
+                [this, i]{
+                    this->loop(i);
+                }
+            ));
+        } // end for i
     } // end Constructor
 
 
@@ -71,11 +161,92 @@ public:
       */
     void add_job(const std::string& kr_str_LABEL_, callback_t job_CALLBACK_)
     {
-        std::lock_guard guard(m_mtx_jobs);
-        m_queue_jobs.push(std::make_pair(kr_str_LABEL_, job_CALLBACK_));
+        add_jobs(std::vector<std::string>{kr_str_LABEL_}, 
+            [job_CALLBACK_](std::vector<std::string> vect_labels)
+            {
+                job_CALLBACK_(std::move(vect_labels.front()));
+            } // end lambda
+        );
     } // end method add_job
 
 
+    /** @brief Add a batch of strings to send to labelg as a single job
+      * @param vect_labels_ The labels to convert to cannonical labels
+      * @param job_CALLBACK_ Invoked once with all cannonical labels, in
+      *        the order of vect_labels_
+      * @remarks Every label is routed to the worker owning its hash, so a
+      *          label is always memoized by the same worker. The batch is
+      *          split into one job per worker it touches and the callback
+      *          is invoked by whichever worker finishes last.
+      */
+    void add_jobs(std::vector<std::string> vect_labels_, batch_callback_t job_CALLBACK_)
+    {
+        if (1 == m_vect_shards.size())
+        {
+            push_job(0, std::move(vect_labels_), std::move(job_CALLBACK_));
+            return;
+        } // end if
+
+        if (true == vect_labels_.empty())
+        {
+            job_CALLBACK_(std::move(vect_labels_));
+            return;
+        } // end if
+
+        //! collects the answers of the workers sharing the batch
+        auto p_join = std::make_shared<BatchJoin>();
+
+        p_join->m_vect_labels.resize(vect_labels_.size());
+        p_join->m_callback = std::move(job_CALLBACK_);
+
+        //! position in the batch of each label routed to a worker
+        std::vector<std::vector<std::size_t>> vect_positions(m_vect_shards.size());
+        std::vector<std::vector<std::string>> vect_parts(m_vect_shards.size());
+
+        for (std::size_t i{0}; i < vect_labels_.size(); i++)
+        {
+            const std::size_t ku_li_shard = shard_of(vect_labels_[i]);
+
+            vect_positions[ku_li_shard].push_back(i);
+            vect_parts[ku_li_shard].push_back(std::move(vect_labels_[i]));
+        } // end for i
+
+        std::size_t u_li_parts{0};
+
+        for (const auto& kr_part : vect_parts)
+        {
+            u_li_parts += kr_part.empty() ? 0 : 1;
+        } // end for kr_part
+
+        p_join->m_u_li_remaining = u_li_parts;
+
+        for (std::size_t s{0}; s < m_vect_shards.size(); s++)
+        {
+            if (true == vect_parts[s].empty())
+            {
+                continue;
+            } // end if
+
+            push_job(s, std::move(vect_parts[s]),
+                [p_join, vect_positions_ = std::move(vect_positions[s])](std::vector<std::string> vect_part_)
+                {
+                    // every worker writes disjoint positions
+                    for (std::size_t k{0}; k < vect_part_.size(); k++)
+                    {
+                        p_join->m_vect_labels[vect_positions_[k]] = std::move(vect_part_[k]);
+                    } // end for k
+
+                    // the last worker done hands the batch back
+                    if (1 == p_join->m_u_li_remaining.fetch_sub(1, std::memory_order_acq_rel))
+                    {
+                        p_join->m_callback(std::move(p_join->m_vect_labels));
+                    } // end if
+                } // end lambda
+            );
+        } // end for s
+    } // end method add_jobs
+
+
     /** @brief Checks if the worker thread is still running or whether it has
      *         terminated since the last call to @see start_up.
      *  @remark Note that this function will only return false if the thread
@@ -84,123 +255,248 @@ public:
      */
     bool is_worker_still_running(void)
     {
-        return false == m_queue_terminate.empty();
+        return false == m_b_failed;
     } // end method is_thread_still_running
 
+
+    /** @brief Whether labels are computed by nauty in-process rather than 
+      *        by the external labelg program.
+      */
+    bool is_in_process(void) const noexcept
+    {
+        return m_b_in_process;
+    } // end method is_in_process
+
 private:
-    /** @brief Main loop of worker threads. Consumes jobs in the queue
-     *         until a terminate signal is pushed into the terminate queue.
+    //! a batch of labels and the callback receiving their cannonical labels
+    using job_t = std::pair<std::vector<std::string>, batch_callback_t>;
+
+
+    /** @brief The queue and memo table owned by a single worker.*/
+    struct Shard
+    {
+        //! queue to receive work
+        std::queue<job_t> m_queue_jobs;
+        //! mutex protecting the job queue
+        std::mutex m_mtx;
+        //! signaled when a job is queued or the workers terminate
+        std::condition_variable m_cv;
+
+        //! labels already computed by this worker, only it touches them
+        std::unordered_map<std::string, std::string> m_umap_memo;
+    }; // end struct Shard
+
+
+    /** @brief Reassembles a batch that was split across workers.*/
+    struct BatchJoin
+    {
+        //! cannonical labels in the order of the batch
+        std::vector<std::string> m_vect_labels;
+        //! the callback of the whole batch
+        batch_callback_t m_callback;
+        //! workers that haven't returned their part yet
+        std::atomic<std::size_t> m_u_li_remaining{0};
+    }; // end struct BatchJoin
+
+
+    /** @brief The worker owning a label.*/
+    std::size_t shard_of(const std::string& kr_str_LABEL_) const
+    {
+        return std::hash<std::string>{}(kr_str_LABEL_) % m_vect_shards.size();
+    } // end method shard_of
+
+
+    /** @brief Queues a job for a worker and wakes it up.*/
+    void push_job(const std::size_t ku_li_SHARD_, std::vector<std::string> vect_labels_, batch_callback_t job_CALLBACK_)
+    {
+        Shard& r_shard = *m_vect_shards[ku_li_SHARD_];
+
+        { // lock_guard scope
+            std::lock_guard guard(r_shard.m_mtx);
+            r_shard.m_queue_jobs.emplace(std::move(vect_labels_), std::move(job_CALLBACK_));
+        } // end lock_guard
+
+        r_shard.m_cv.notify_one();
+    } // end method push_job
+
+
+    /** @brief Main loop of worker threads. Sleeps until a job is queued
+     *         for this worker and consumes jobs until the destructor
+     *         signals the workers to terminate.
+     *  @param ku_li_ID_ Index of the worker, selects its shard and its 
+     *         labelg coprocess
      *  @remark If the Popen call fails, it will discard the current job
      *          and terminate. The callback will never be invoked in that 
      *          case which means this error may be fatal.
      */
-    void loop(void)
+    void loop(const std::size_t ku_li_ID_)
     {
-        // size of the buffer used to communicate with labelg
-        constexpr std::size_t ku_li_buffer_size = 64;
+        Shard& r_shard = *m_vect_shards[ku_li_ID_];
 
-        // queues are thread-safe, there might be a nicer way
-        // to signal a terminate, but it doesn't really matter
-        while(m_queue_terminate.empty() == true)
+        while (true)
         {   
-            std::pair<std::string, callback_t> job;
+            job_t job;
 
-            if (m_queue_jobs.empty() == true)
-            {
-                // nothing to do
-                std::this_thread::yield();
-                continue;
-            } // end if
-            else
-            {
-                // get the next job
-                std::lock_guard guard(m_mtx_jobs);
-                job = std::move(m_queue_jobs.front());
-                m_queue_jobs.pop();
-            } // end else
-
-            // sending an empty string to labelg will probably
-            // cause some unwanted side-effects like crashing
-            if (false == job.first.empty())
-            {
-                if(1 == m_umap_memo_table.count(job.first))
+            { // unique_lock scope
+                std::unique_lock lock(r_shard.m_mtx);
+
+                r_shard.m_cv.wait(lock, [&]{
+                    return true == m_b_terminate || false == r_shard.m_queue_jobs.empty();
+                });
+
+                if (true == r_shard.m_queue_jobs.empty())
                 {
-                    // cannonical label is memoized, no need to popen
-                    job.second(m_umap_memo_table[job.first]);
+                    // woken up to terminate
+                    break;
                 } // end if
-                else
+
+                job = std::move(r_shard.m_queue_jobs.front());
+                r_shard.m_queue_jobs.pop();
+            } // end unique_lock
+
+            for (std::string& r_str_label : job.first)
+            {
+                // sending an empty string to labelg will probably
+                // cause some unwanted side-effects like crashing
+                if (true == r_str_label.empty())
                 {
-                    //! c-style file for popen
-                    FILE* fp;
-                    
-                    //! buffer to read popen pipe 
-                    char p_buffer[ku_li_buffer_size];
-
-                    //! the command to run labelg
-                    std::string str_cmd{m_str_labelg_path};
-                    //! the label returned by labelg
-                    std::string str_cannonical_label;
-                    //! the string read from the popen output
-                    std::string str_output{""};
-
-                    // add the calculated label to the command
-                    str_cmd += " '";
-                    str_cmd += job.first;
-                    str_cmd += "'";
-
-                    // if popen fails there really is no way to recover
-                    // in that case we will inform the user and exit 
-                    // pushing false into the queue allows the user to 
-                    // know that something went wrong via the 
-                    // is_worker_still_running function 
-                    // however, the callback won't be invoked, so there
-                    // will likely be a thread waiting forever for this
-                    if ((fp = popen (str_cmd.c_str(), "r")) == NULL)
-                    {
-                        std::lock_guard guard(m_mtx_terminate);
-                        std::cerr << "call to popen failed!" << std::endl;
-                        std::cerr << "command was: '" << str_cmd << "'" << std::endl;
-                        m_queue_terminate.push(false);
-                        exit(1);
-                    } // end if
+                    continue;
+                } // end if
 
-                    // read the first string from the buffer
-                    while (fgets(p_buffer, sizeof(p_buffer), fp)) 
-                    {
-                        str_output += p_buffer;
-                    } // end while
+                auto it = r_shard.m_umap_memo.find(r_str_label);
+
+                if (it != r_shard.m_umap_memo.end())
+                {
+                    r_str_label = it->second;
+                    continue;
+                } // end if
 
-                    str_cannonical_label = str_output.substr(0, str_output.size() - 1);
-                    pclose(fp);
+                //! the label returned by nauty or labelg
+                std::string str_cannonical = m_b_in_process ? label_in_process(r_str_label) 
+                                           : m_vect_coprocesses.empty() ? label_with_popen(r_str_label) 
+                                           : label_with_coprocess(ku_li_ID_, r_str_label);
 
-                    // memoize cannonical label
-                    m_umap_memo_table[job.first] = str_cannonical_label;
+                r_shard.m_umap_memo.emplace(std::move(r_str_label), str_cannonical);
+                r_str_label = std::move(str_cannonical);
+            } // end for r_str_label
 
-                    // invoke the callback with the return value                
-                    job.second(str_cannonical_label);
-                } // end else
-            } // end if
+            // invoke the callback with the return values
+            job.second(std::move(job.first));
         } // end while
     } // end method loop
 
-    //! worker thread that will run the main loop
-    std::thread m_thread_worker;
+
+    /** @brief Computes the cannonical label by linking against nauty.
+      * @param kr_str_LABEL_ The label to convert to a cannonical label
+      */
+    std::string label_in_process(const std::string& kr_str_LABEL_)
+    {
+        #if _USE_NAUTY
+            return Nauty_Canon::canonical_label(kr_str_LABEL_);
+        #else
+            // start_up refuses to select this backend without nauty
+            return kr_str_LABEL_;
+        #endif
+    } // end method label_in_process
+
+
+    /** @brief Computes the cannonical label by running the external labelg.
+      * @param kr_str_LABEL_ The label to convert to a cannonical label
+      * @remark If popen fails, the process is terminated.
+      */
+    std::string label_with_popen(const std::string& kr_str_LABEL_)
+    {
+        // size of the buffer used to communicate with labelg
+        constexpr std::size_t ku_li_buffer_size = 64;
+
+        //! c-style file for popen
+        FILE* fp;
+        
+        //! buffer to read popen pipe 
+        char p_buffer[ku_li_buffer_size];
+
+        //! the command to run labelg
+        std::string str_cmd{m_str_labelg_path};
+        //! the string read from the popen output
+        std::string str_output{""};
+
+        // add the calculated label to the command
+        str_cmd += " '";
+        str_cmd += kr_str_LABEL_;
+        str_cmd += "'";
+
+        // if popen fails there really is no way to recover
+        // in that case we will inform the user and exit 
+        // raising the failure signal allows the user to 
+        // know that something went wrong via the 
+        // is_worker_still_running function 
+        // however, the callback won't be invoked, so there
+        // will likely be a thread waiting forever for this
+        if ((fp = popen (str_cmd.c_str(), "r")) == NULL)
+        {
+            std::lock_guard guard(m_mtx_error);
+            std::cerr << "call to popen failed!" << std::endl;
+            std::cerr << "command was: '" << str_cmd << "'" << std::endl;
+            m_b_failed = true;
+            exit(1);
+        } // end if
+
+        // read the first string from the buffer
+        while (fgets(p_buffer, sizeof(p_buffer), fp)) 
+        {
+            str_output += p_buffer;
+        } // end while
+
+        pclose(fp);
+
+        return str_output.substr(0, str_output.size() - 1);
+    } // end method label_with_popen
+
+
+    /** @brief Computes the cannonical label by streaming it through the 
+      *        labelg coprocess owned by the given worker.
+      * @param ku_li_ID_ Index of the calling worker
+      * @param kr_str_LABEL_ The label to convert to a cannonical label
+      * @remark If labelg stops answering, the process is terminated.
+      */
+    std::string label_with_coprocess(const std::size_t ku_li_ID_, const std::string& kr_str_LABEL_)
+    {
+        std::string str_cannonical_label;
+
+        // like a failed popen, a dead coprocess can't be recovered from
+        if (false == m_vect_coprocesses[ku_li_ID_]->label(kr_str_LABEL_, str_cannonical_label))
+        {
+            std::lock_guard guard(m_mtx_error);
+            std::cerr << "labelg coprocess " << ku_li_ID_ << " stopped responding!" << std::endl;
+            std::cerr << "label was: '" << kr_str_LABEL_ << "'" << std::endl;
+            m_b_failed = true;
+            exit(1);
+        } // end if
+
+        return str_cannonical_label;
+    } // end method label_with_coprocess
+
+    //! worker threads that will run the main loop
+    std::vector<std::thread> m_vect_workers;
+
+    //! persistent labelg processes, one per worker
+    std::vector<std::unique_ptr<LabelGCoprocess>> m_vect_coprocesses;
 
     //! path to the labelg executable
     std::string m_str_labelg_path;
+    //! whether nauty is called directly instead of labelg
+    bool m_b_in_process = false;
 
-    //! queue to receive work
-    std::queue<std::pair<std::string, callback_t>> m_queue_jobs;
-    //! used to signal thread to terminate
-    std::queue<bool> m_queue_terminate;
+    //! the queue and memo table of each worker
+    std::vector<std::unique_ptr<Shard>> m_vect_shards;
 
-    //! memoization table for motifs
-    std::unordered_map<std::string, std::string> m_umap_memo_table;
+    //! used to signal threads to terminate
+    std::atomic<bool> m_b_terminate{false};
+    //! raised if a worker failed to label
+    std::atomic<bool> m_b_failed{false};
 
-    //! mutex protecting job queue
-    std::mutex m_mtx_jobs;
-    //! mutex protecting terminate queue
-    std::mutex m_mtx_terminate;
+    //! serializes error reports of the workers
+    std::mutex m_mtx_error;
 }; // end class LabelGProvider
 
 #endif // !__LABEL_G_PROVIDER_HPP
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef __MOTIF_CLASS_TABLE_HPP
+#define __MOTIF_CLASS_TABLE_HPP
+
+#include <vector>   // vector
+#include <utility>  // pair
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint16_t, uint32_t
+#include <memory>   // unique_ptr
+#include <mutex>    // once_flag, call_once
+
+#include "MotifCode.hpp" // MotifCode
+
+
+/** @brief Dense lookup table from the raw adjacency of a small subgraph to
+  *        its isomorphism class.
+  * @remark The raw adjacency is the adjacency of a MotifCode, one bit per
+  *         vertex pair in the order graph6 writes them. For undirected k <= 6
+  *         that is at most 2^15 patterns and for directed k <= 4 at most
+  *         2^12, so every pattern is classified once by brute force over all
+  *         vertex permutations. The cannonical code of a class is only
+  *         computed the first time the class is seen, after which labeling
+  *         a subgraph costs a single array load.
+  */
+class MotifClassTable
+{
+public:
+    //! raw adjacency, bit p set if the p-th vertex pair is an edge
+    using mask_t = std::uint32_t;
+
+    //! largest undirected subgraph size with a table
+    static constexpr std::size_t ku_li_MAX_UNDIRECTED = 6;
+    //! largest directed subgraph size with a table
+    static constexpr std::size_t ku_li_MAX_DIRECTED = 4;
+
+
+    /** @brief Returns the table shared by the process for the given
+      *        subgraph size, building it on first use.
+      * @return nullptr if the size is too large to tabulate.
+      */
+    static const MotifClassTable* get(std::size_t u_li_k_, bool b_directed_);
+
+
+    /** @brief Reads the raw adjacency bitmask of a motif code.*/
+    mask_t mask_of(const MotifCode k_RAW_) const noexcept
+    {
+        return static_cast<mask_t>(k_RAW_ & Motif_Code::low_bits(m_vect_pairs.size()));
+    } // end method mask_of
+
+
+    /** @brief The isomorphism class of a raw adjacency bitmask.*/
+    std::size_t class_of(mask_t mask_) const
+    {
+        return m_vect_class[mask_];
+    } // end method class_of
+
+
+    /** @brief Number of isomorphism classes in the table.*/
+    std::size_t n_classes(void) const noexcept
+    {
+        return m_vect_representatives.size();
+    } // end method n_classes
+
+
+    /** @brief The motif code of the representative of a class.*/
+    MotifCode representative(std::size_t u_li_class_) const noexcept
+    {
+        return Motif_Code::empty(mu_li_k, m_b_directed) | m_vect_representatives[u_li_class_];
+    } // end method representative
+
+
+    /** @brief Returns the cannonical code of the class of a raw code.
+      * @param labeler_ Invoked with the raw code of the representative of
+      *        the class the first time the class is seen, must return the
+      *        cannonical code of that representative.
+      * @remark Concurrent callers hitting an unlabeled class wait for the
+      *         one labeling it.
+      */
+    template<typename Labeler>
+    MotifCode label(const MotifCode k_RAW_, Labeler&& labeler_) const
+    {
+        const std::size_t ku_li_class = class_of(mask_of(k_RAW_));
+
+        std::call_once(m_p_once_labeled[ku_li_class], [&]{
+            m_vect_labels[ku_li_class] = labeler_(representative(ku_li_class));
+        });
+
+        return m_vect_labels[ku_li_class];
+    } // end method label
+
+private:
+    /** @brief Classifies every raw adjacency of the given size.*/
+    MotifClassTable(std::size_t u_li_k_, bool b_directed_);
+
+    MotifClassTable(const MotifClassTable&) = delete;
+    MotifClassTable& operator=(const MotifClassTable&) = delete;
+
+    //! subgraph size
+    std::size_t mu_li_k;
+    //! whether edges are directed
+    bool m_b_directed;
+
+    //! (row, column) of each mask bit in motif code order
+    std::vector<std::pair<std::uint8_t, std::uint8_t>> m_vect_pairs;
+    //! class of every raw adjacency bitmask
+    std::vector<std::uint16_t> m_vect_class;
+    //! the smallest bitmask of each class
+    std::vector<mask_t> m_vect_representatives;
+
+    //! cannonical code of each class, filled on first use
+    mutable std::vector<MotifCode> m_vect_labels;
+    //! guards the one-time labeling of each class
+    mutable std::unique_ptr<std::once_flag[]> m_p_once_labeled;
+}; // end class MotifClassTable
+
+#endif // !__MOTIF_CLASS_TABLE_HPP
@@ -0,0 +1,286 @@
+#pragma once
+
+#ifndef __MOTIF_CODE_HPP
+#define __MOTIF_CODE_HPP
+
+#include <string>    // string
+#include <vector>    // vector
+#include <cstddef>   // size_t
+#include <cstdint>   // uint64_t
+#include <stdexcept> // invalid_argument
+#include <utility>   // pair
+#include <array>     // array
+
+
+/** @brief A motif label packed into a single integer.
+  * @remark Bits 60-63 hold the number of vertices, bit 59 is set for
+  *         directed motifs and bits 0-55 hold the adjacency, one bit per
+  *         vertex pair in the order graph6 (or digraph6) writes them. That
+  *         is enough for undirected motifs of up to 11 vertices and
+  *         directed motifs of up to 8 vertices. Codes are only turned into
+  *         graph6 text when they are written out.
+  */
+using MotifCode = std::uint64_t;
+
+
+namespace Motif_Code
+{
+    //! largest undirected motif that fits a code
+    constexpr std::size_t ku_li_MAX_UNDIRECTED = 11;
+    //! largest directed motif that fits a code
+    constexpr std::size_t ku_li_MAX_DIRECTED = 8;
+
+    //! position of the vertex count
+    constexpr unsigned ku_ORDER_SHIFT = 60;
+    //! flag marking directed motifs
+    constexpr MotifCode k_DIRECTED_FLAG = MotifCode{1} << 59;
+
+
+    /** @brief Number of adjacency bits of a motif, one per vertex pair, or
+      *        per ordered pair if directed.
+      */
+    constexpr std::size_t code_bits(const std::size_t ku_li_ORDER_, const bool k_b_DIRECTED_) noexcept
+    {
+        return k_b_DIRECTED_ ? ku_li_ORDER_ * (ku_li_ORDER_ - 1) : ku_li_ORDER_ * (ku_li_ORDER_ - 1) / 2;
+    } // end method code_bits
+
+
+    /** @brief Number of characters of the graph6 or digraph6 label of a
+      *        motif, the '&' of digraph6 included.
+      * @remark digraph6 writes whole rows, diagonal included.
+      */
+    constexpr std::size_t g6_length(const std::size_t ku_li_ORDER_, const bool k_b_DIRECTED_) noexcept
+    {
+        return k_b_DIRECTED_ ? 2 + (ku_li_ORDER_ * ku_li_ORDER_ + 5) / 6 : 1 + (code_bits(ku_li_ORDER_, false) + 5) / 6;
+    } // end method g6_length
+
+
+    //! longest label of a motif that fits a code
+    constexpr std::size_t ku_li_MAX_G6_LENGTH = g6_length(ku_li_MAX_DIRECTED, true) > g6_length(ku_li_MAX_UNDIRECTED, false)
+                                              ? g6_length(ku_li_MAX_DIRECTED, true) : g6_length(ku_li_MAX_UNDIRECTED, false);
+
+
+    /** @brief The vertex pair (i, j), i < j, behind a bit of an undirected
+      *        code, the pairs go column by column through the upper triangle.
+      */
+    constexpr std::pair<std::size_t, std::size_t> pair_of_bit(std::size_t u_li_bit_) noexcept
+    {
+        std::size_t u_li_j{1};
+
+        while (u_li_bit_ >= u_li_j)
+        {
+            u_li_bit_ -= u_li_j;
+            u_li_j++;
+        } // end while
+
+        return {u_li_bit_, u_li_j};
+    } // end method pair_of_bit
+
+
+    /** @brief Whether motifs of the given size can be stored in a code.*/
+    inline bool fits(const std::size_t ku_li_ORDER_, const bool k_b_DIRECTED_) noexcept
+    {
+        return ku_li_ORDER_ <= (k_b_DIRECTED_ ? ku_li_MAX_DIRECTED : ku_li_MAX_UNDIRECTED);
+    } // end method fits
+
+
+    /** @brief Number of vertices of the motif.*/
+    inline std::size_t order(const MotifCode k_CODE_) noexcept
+    {
+        return static_cast<std::size_t>(k_CODE_ >> ku_ORDER_SHIFT);
+    } // end method order
+
+
+    /** @brief Whether the motif is directed.*/
+    inline bool is_directed(const MotifCode k_CODE_) noexcept
+    {
+        return 0 != (k_CODE_ & k_DIRECTED_FLAG);
+    } // end method is_directed
+
+
+    /** @brief The code of a motif with the given size and no edges.*/
+    inline MotifCode empty(const std::size_t ku_li_ORDER_, const bool k_b_DIRECTED_) noexcept
+    {
+        return (MotifCode{ku_li_ORDER_} << ku_ORDER_SHIFT) | (k_b_DIRECTED_ ? k_DIRECTED_FLAG : 0);
+    } // end method empty
+
+
+    /** @brief Packs an adjacency matrix, matrix[i][j] being the edge i -> j.
+      * @remark The matrix must fit a code, @see fits.
+      */
+    inline MotifCode from_matrix(const std::vector<std::vector<bool>>& kr_MATRIX_, const bool k_b_DIRECTED_)
+    {
+        const std::size_t ku_li_order = kr_MATRIX_.size();
+        MotifCode code = empty(ku_li_order, k_b_DIRECTED_);
+        unsigned u_bit{0};
+
+        if (false == k_b_DIRECTED_)
+        {
+            // upper triangle, column by column
+            for (std::size_t j{0}; j < ku_li_order; j++)
+            {
+                for (std::size_t i{0}; i < j; i++, u_bit++)
+                {
+                    if (true == kr_MATRIX_[i][j])
+                    {
+                        code |= MotifCode{1} << u_bit;
+                    } // end if
+                } // end for i
+            } // end for j
+        } // end if
+        else
+        {
+            // row by row, skipping the diagonal
+            for (std::size_t i{0}; i < ku_li_order; i++)
+            {
+                for (std::size_t j{0}; j < ku_li_order; j++)
+                {
+                    if (i == j)
+                    {
+                        continue;
+                    } // end if
+
+                    if (true == kr_MATRIX_[i][j])
+                    {
+                        code |= MotifCode{1} << u_bit;
+                    } // end if
+
+                    u_bit++;
+                } // end for j
+            } // end for i
+        } // end else
+
+        return code;
+    } // end method from_matrix
+
+
+    /** @brief Mirrors the low six bits, graph6 writes the first bit as
+      *        the most significant bit of each character.
+      */
+    constexpr unsigned reverse6(const unsigned ku_BITS_) noexcept
+    {
+        return ((ku_BITS_ & 1) << 5) | ((ku_BITS_ & 2) << 3) | ((ku_BITS_ & 4) << 1)
+             | ((ku_BITS_ & 8) >> 1) | ((ku_BITS_ & 16) >> 3) | ((ku_BITS_ & 32) >> 5);
+    } // end method reverse6
+
+
+    /** @brief Mask of the lowest n bits, n <= 64.*/
+    constexpr std::uint64_t low_bits(const std::size_t ku_li_N_) noexcept
+    {
+        return ku_li_N_ >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << ku_li_N_) - 1;
+    } // end method low_bits
+
+
+    /** @brief Parses a graph6 or digraph6 ('&' prefixed) label.
+      * @throws std::invalid_argument If the label is malformed, has
+      *         self-loops or is too large for a code.
+      */
+    inline MotifCode from_g6(const std::string& kr_str_LABEL_)
+    {
+        const bool kb_directed = (false == kr_str_LABEL_.empty() && '&' == kr_str_LABEL_[0]);
+        const std::size_t ku_li_start = kb_directed ? 1 : 0;
+
+        if (kr_str_LABEL_.size() <= ku_li_start)
+        {
+            throw std::invalid_argument("Empty graph6 label");
+        } // end if
+
+        const std::size_t ku_li_order = static_cast<std::size_t>(kr_str_LABEL_[ku_li_start] - 63);
+
+        if (kr_str_LABEL_[ku_li_start] < 63 || false == fits(ku_li_order, kb_directed))
+        {
+            throw std::invalid_argument("graph6 label '" + kr_str_LABEL_ + "' is too large for a motif code");
+        } // end if
+
+        const std::size_t ku_li_bits = kb_directed ? ku_li_order * ku_li_order : code_bits(ku_li_order, false);
+        const std::size_t ku_li_chars = g6_length(ku_li_order, kb_directed) - ku_li_start - 1;
+
+        if (kr_str_LABEL_.size() < ku_li_start + 1 + ku_li_chars)
+        {
+            throw std::invalid_argument("graph6 label '" + kr_str_LABEL_ + "' is truncated");
+        } // end if
+
+        //! the bits of the label, first bit lowest
+        std::uint64_t u_bits{0};
+
+        for (std::size_t t{0}; t < ku_li_chars; t++)
+        {
+            const unsigned ku_chunk = static_cast<unsigned>(kr_str_LABEL_[ku_li_start + 1 + t] - 63) & 63;
+            u_bits |= std::uint64_t{reverse6(ku_chunk)} << (6 * t);
+        } // end for t
+
+        // drop the padding of the last character
+        u_bits &= low_bits(ku_li_bits);
+
+        if (false == kb_directed)
+        {
+            return empty(ku_li_order, false) | u_bits;
+        } // end if
+
+        // digraph6 stores whole rows, the diagonal is squeezed out
+        MotifCode code = empty(ku_li_order, true);
+        const std::size_t ku_li_row = ku_li_order - 1;
+
+        for (std::size_t i{0}; i < ku_li_order; i++)
+        {
+            const std::uint64_t ku_row = (u_bits >> (i * ku_li_order)) & low_bits(ku_li_order);
+
+            if (0 != (ku_row & (std::uint64_t{1} << i)))
+            {
+                throw std::invalid_argument("digraph6 label '" + kr_str_LABEL_ + "' has a self-loop");
+            } // end if
+
+            code |= ((ku_row & low_bits(i)) | ((ku_row >> (i + 1)) << i)) << (i * ku_li_row);
+        } // end for i
+
+        return code;
+    } // end method from_g6
+
+
+    /** @brief Writes a code as graph6, or as digraph6 if it is directed.*/
+    inline std::string to_g6(const MotifCode k_CODE_)
+    {
+        const std::size_t ku_li_order = order(k_CODE_);
+        const bool kb_directed = is_directed(k_CODE_);
+        const std::size_t ku_li_length = g6_length(ku_li_order, kb_directed);
+
+        //! the bits of the label, first bit lowest
+        std::uint64_t u_bits{0};
+
+        if (false == kb_directed)
+        {
+            u_bits = k_CODE_ & low_bits(code_bits(ku_li_order, false));
+        } // end if
+        else
+        {
+            // digraph6 stores whole rows, so an empty diagonal is spread in
+            const std::size_t ku_li_row = ku_li_order - 1;
+
+            for (std::size_t i{0}; i < ku_li_order; i++)
+            {
+                const std::uint64_t ku_row = (k_CODE_ >> (i * ku_li_row)) & low_bits(ku_li_row);
+                u_bits |= ((ku_row & low_bits(i)) | ((ku_row >> i) << (i + 1))) << (i * ku_li_order);
+            } // end for i
+        } // end else
+
+        // the label is assembled in place and copied into the string once
+        std::array<char, ku_li_MAX_G6_LENGTH> arr_label{};
+        std::size_t u_li_at{0};
+
+        if (true == kb_directed)
+        {
+            arr_label[u_li_at++] = '&';
+        } // end if
+
+        arr_label[u_li_at++] = static_cast<char>(63 + ku_li_order);
+
+        for (std::size_t t{0}; u_li_at < ku_li_length; t++)
+        {
+            arr_label[u_li_at++] = static_cast<char>(63 + reverse6(static_cast<unsigned>(u_bits >> (6 * t)) & 63));
+        } // end for t
+
+        return std::string(arr_label.data(), ku_li_length);
+    } // end method to_g6
+} // end namespace Motif_Code
+
+#endif // !__MOTIF_CODE_HPP
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef __NEMOLIB_NAUTY_CANON_HPP
+#define __NEMOLIB_NAUTY_CANON_HPP
+
+#include <string>        // string
+
+#include "Config.hpp"    // _USE_NAUTY
+#include "MotifCode.hpp" // MotifCode
+
+#if _USE_NAUTY
+
+// nauty's headers define a lot of macros (TRUE, MAXN, graph, set, ...), 
+// they are only included by the translation unit implementing this namespace
+namespace Nauty_Canon
+{
+    /** @brief Computes the cannonical label of a graph6 or digraph6 string
+      *        by calling nauty directly, without spawning labelg.
+      * @param kr_str_LABEL_ The graph6 (or '&'-prefixed digraph6) label
+      * @return The cannonical label in the same format labelg would print
+      *         it, without the trailing newline.
+      * @remark nauty keeps its work space in static storage unless it was
+      *         built thread-safe, so concurrent calls are serialized unless
+      *         nautyT is linked (meson option nauty_tls).
+      */
+    std::string canonical_label(const std::string& kr_str_LABEL_);
+
+
+    /** @brief Computes the cannonical code of a motif code by calling nauty
+      *        directly, the graph is filled from the adjacency bits and the
+      *        cannonical graph packed back without any text in between.
+      * @param k_RAW_ The motif code to label, it must fit a code
+      * @return The code of the label canonical_label would give it.
+      * @remark Serialized like canonical_label unless nautyT is linked.
+      */
+    MotifCode canonical_code(const MotifCode k_RAW_);
+} // end namespace Nauty_Canon
+
+#endif // _USE_NAUTY
+
+#endif // !__NEMOLIB_NAUTY_CANON_HPP
@@ -20,11 +20,18 @@
 
 #include <unordered_map>  // unordered_map
 #include <future>         // packaged_task, future
+#include <stdexcept>      // invalid_argument
+#include <utility>        // index_sequence
 
 #include "LabelGProvider.hpp"
 #include "Config.hpp"
 #include "graph64.hpp"
 #include "Subgraph.hpp"
+#include "InlineSubgraph.hpp"
+#include "CSRGraph.hpp"
+#include "MotifClassTable.hpp"
+#include "MotifCode.hpp"
+#include "NautyCanon.hpp"
 
 
 typedef uint64_t graph64; //Nauty label
@@ -32,19 +39,62 @@ typedef uint64_t graph64; //Nauty label
 class NautyLink
 {
 public:
-	NautyLink(const std::string& kr_str_LABELG_PATH_, int subgraphsize, std::unordered_map<edge, edgetype> edgeset, bool dir = false) 
-     : directed(dir), G_N(subgraphsize), edges(edgeset)
+	// an empty labelg path selects the in-process nauty labeler, the
+	// graph is only referenced and must outlive the NautyLink
+	NautyLink(const LabelGOptions& kr_LABELG_OPTIONS_, int subgraphsize, const CSRGraph& graph) 
+     : m_b_in_process(kr_LABELG_OPTIONS_.m_str_labelg_path.empty()), directed(graph.isDirected()), G_N(subgraphsize), m_p_graph(&graph)
 	{
-        m_lgp_cannonical_labeler.start_up(kr_str_LABELG_PATH_);
+		if (false == Motif_Code::fits(subgraphsize, directed))
+		{
+			throw std::invalid_argument("Motif size " + std::to_string(subgraphsize) + " is too large for 64-bit motif codes");
+		} // end if
+
+		// nauty is called on the enumerating threads, only labelg needs workers
+		if (false == m_b_in_process)
+		{
+			m_lgp_cannonical_labeler.start_up(kr_LABELG_OPTIONS_);
+		} // end if
+		else if (false == _USE_NAUTY)
+		{
+			throw std::invalid_argument("NemoLib was built without nauty, a path to labelg is required");
+		} // end elif
+
+		#if _USE_MOTIF_CLASS_TABLE
+			m_p_class_table = MotifClassTable::get(subgraphsize, directed);
+		#endif
 	}
 
+	// labels using nauty directly, requires NemoLib to be built with nauty
+	NautyLink(int subgraphsize, const CSRGraph& graph)
+	 : NautyLink(LabelGOptions{}, subgraphsize, graph)
+	{}
+
     virtual ~NautyLink() = default;
     void nautyinit();
 
     void getAdjacency(Subgraph& subgraph, std::vector<std::vector<bool>>& matrix);
 
 
-    std::string nautylabel_helper(Subgraph&);
+    MotifCode nautylabel_helper(Subgraph&);
+
+	// labels many subgraphs with at most one round trip to the labeler
+	void nautylabel_batch(const std::vector<Subgraph>& subgraphs, std::vector<MotifCode>& labels);
+	void nautylabel_batch(const std::vector<InlineSubgraph>& subgraphs, std::vector<MotifCode>& labels);
+
+	// cannonical codes of raw codes, in order, with at most one round trip
+	void label_batch(const std::vector<MotifCode>& raw_codes, std::vector<MotifCode>& labels);
+
+	// packs the adjacency of a subgraph, one edge lookup per vertex pair
+	MotifCode raw_code(const Subgraph& subgraph);
+	MotifCode raw_code(const InlineSubgraph& subgraph);
+
+	// raw code of K vertices numbered as in the snapshot, the lookups are
+	// unrolled into one expression per vertex pair
+	template <std::size_t K>
+	MotifCode raw_code(const vertex* nodes) const
+	{
+		return Motif_Code::empty(K, directed) | raw_code_pairs<K>(nodes, std::make_index_sequence<K * (K - 1) / 2>{});
+	}
 
 	int get_G_N()
 	{
@@ -52,7 +102,56 @@ public:
 	}
 
 private:
+	// cannonical code of a raw code, from the cache or the labeler
+	MotifCode cannonical_code(MotifCode raw);
+
+	// parses the labeler's answer for a raw code, throws if the answer
+	// isn't a graph of the same order and directedness
+	static MotifCode answer_code(MotifCode raw, const std::string& label);
+
+	// raw code of vertices numbered as in the Graph
+	MotifCode raw_code(const vertex* graph_nodes, std::size_t subsize);
+
+	// sends graph6 labels to the labeler as one job and waits for them
+	std::vector<std::string> request_labels(std::vector<std::string> labels);
+
+	// folds the bits of every vertex pair, P enumerates the pairs in the
+	// graph6 order of undirected codes
+	template <std::size_t K, std::size_t... P>
+	MotifCode raw_code_pairs(const vertex* nodes, std::index_sequence<P...>) const
+	{
+		if (false == directed)
+		{
+			return (MotifCode{0} | ... | (static_cast<MotifCode>(m_p_graph->hasEdge(nodes[Motif_Code::pair_of_bit(P).first], nodes[Motif_Code::pair_of_bit(P).second])) << P));
+		}
+
+		return (MotifCode{0} | ... | directed_bits<K, Motif_Code::pair_of_bit(P).first, Motif_Code::pair_of_bit(P).second>(nodes));
+	}
+
+	// both directions of the pair (I, J), I < J, from a single lookup,
+	// edge types are relative to the first vertex
+	template <std::size_t K, std::size_t I, std::size_t J>
+	MotifCode directed_bits(const vertex* nodes) const
+	{
+		// larger directed motifs don't fit a code, the constructor refuses them
+		if constexpr (K <= Motif_Code::ku_li_MAX_DIRECTED)
+		{
+			const edgetype et = m_p_graph->edgeType(nodes[I], nodes[J]);
+
+			return (0 != (et & DIR_U_T_V) ? MotifCode{1} << (I * (K - 1) + J - 1) : MotifCode{0})
+			     | (0 != (et & DIR_V_T_U) ? MotifCode{1} << (J * (K - 1) + I) : MotifCode{0});
+		}
+		else
+		{
+			return MotifCode{0};
+		}
+	}
+
     LabelGProvider m_lgp_cannonical_labeler;
+	// whether codes are labeled by nauty in-process rather than by labelg
+	bool m_b_in_process;
+	// isomorphism classes of the subgraph size, nullptr if too large
+	const MotifClassTable* m_p_class_table = nullptr;
     bool directed;
     int G_N; // subgraphsize
     int G_M;
@@ -60,7 +159,8 @@ private:
     int ptn[MAXN];
     int orbits[MAXN];
 
-	std::unordered_map<edge, edgetype> edges; // get the edges when initialize it
+	// edges are looked up in the snapshot, subgraphs are numbered as in the Graph
+	const CSRGraph* m_p_graph;
 };
 
 #endif /* NAUTYLINK_H */
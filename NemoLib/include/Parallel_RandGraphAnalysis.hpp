@@ -4,7 +4,6 @@
 #include <unordered_map>            // unordered_map
 #include <vector>                   // vector
 #include <cstddef>                  // size_t
-#include <string>                   // string
       
 #include "Config.hpp"               // configuration defines
 #include "SubgraphCount.hpp"        // SubgraphCount
@@ -19,11 +18,11 @@ namespace Parallel_Analysis
 {
 	struct AnalyzeArgPack
 	{
-		AnalyzeArgPack(const Graph* g_, const std::size_t rgc_, const std::size_t sgs_, std::vector<double>& p_, ThreadPool* pool, const std::string& lgp_)
-		 : m_graph_target(*g_), m_tp_pool(pool), mu_li_graph_count(rgc_), mu_li_subgraph_size(sgs_), m_vectd_probabilities(p_), m_str_labelg_path(lgp_)
+		AnalyzeArgPack(const CSRGraph* g_, const std::size_t rgc_, const std::size_t sgs_, std::vector<double>& p_, ThreadPool* pool, const LabelGOptions& lgo_, const CSROptions& csro_ = CSROptions{})
+		 : m_graph_target(*g_), m_tp_pool(pool), mu_li_graph_count(rgc_), mu_li_subgraph_size(sgs_), m_vectd_probabilities(p_), m_labelg_options(lgo_), m_csr_options(csro_)
 		{}
 
-		const Graph& m_graph_target;
+		const CSRGraph& m_graph_target;
 
 		ThreadPool* m_tp_pool;
 
@@ -32,17 +31,19 @@ namespace Parallel_Analysis
 
 		std::vector<double>& m_vectd_probabilities;
 
-		const std::string& m_str_labelg_path;
+		const LabelGOptions m_labelg_options;
+
+		const CSROptions m_csr_options;
 	};
 
 
-std::unordered_map<std::string, std::vector<double>> analyze(AnalyzeArgPack& args)
+std::unordered_map<MotifCode, std::vector<double>> analyze(AnalyzeArgPack& args)
 	{
 		// create the return map and fill it with the labels we found in the
 		// target graph, as those are the only labels about which we care
 		// TODO consider changing this, as it creates the precondition of
 		// executing the target graph analysis first
-		std::unordered_map<std::string, std::vector<double>> labelRelFreqsMap;
+		std::unordered_map<MotifCode, std::vector<double>> labelRelFreqsMap;
 		std::vector<SubgraphCount> all_subgraphs(args.mu_li_graph_count);
 
 		for (std::size_t i{0}; i < args.mu_li_graph_count; i++)
@@ -52,14 +53,14 @@ std::unordered_map<std::string, std::vector<double>> analyze(AnalyzeArgPack& arg
 			// generate random graph
 			Graph randomGraph = std::move(RandomGraphGenerator::generate(args.m_graph_target));
 
-			ESU_Parallel::enumerate<SubgraphCount>(randomGraph, &all_subgraphs[i], static_cast<int>(args.mu_li_subgraph_size), args.m_tp_pool, args.m_str_labelg_path);
+			ESU_Parallel::enumerate<SubgraphCount>(randomGraph, &all_subgraphs[i], static_cast<int>(args.mu_li_subgraph_size), args.m_tp_pool, args.m_labelg_options, args.m_csr_options);
 		} // end for i
 
         LOG_F(INFO, "Merging results ...");
 
 		for (auto& subgraphCount : all_subgraphs)
 		{
-			std::unordered_map<std::string, double> curLabelRelFreqMap = std::move(subgraphCount.getRelativeFrequencies());
+			std::unordered_map<MotifCode, double> curLabelRelFreqMap = std::move(subgraphCount.getRelativeFrequencies());
 
 			// populate labelRelReqsMap with result
 			for (const auto& p : curLabelRelFreqMap)
@@ -21,13 +21,15 @@
 
 #include "Config.hpp"
 #include "Graph.hpp"					 // Graph
+#include "CSRGraph.hpp"					 // CSRGraph
 #include "Subgraph.hpp"					 // Subgraph
+#include "ESUEngine.hpp"				 // ESUEngine
+#include "ESUSplitter.hpp"				 // ESUSplitter, ESUSubtree
 #include "NautyLink.hpp"				 // NautyLink
 #include "SubgraphEnumerationResult.hpp" // SubgraphEnumerationResult
 #include "Utility.hpp"					 // get_random_in_range
 #include <vector>						 // vector
 #include <cassert>						 // assert
-#include <algorithm>		             // copy_if
 #include <numeric>			             // iota
 #include <unordered_set>	             // unordered_set
 #include "Logger.hpp"
@@ -41,9 +43,27 @@ public:
 	 *
 	 * @param graph           the graph on which to execute RAND-ESU
 	 * @param subgraphSize    the size of the target Subgraphs
+	 * @param csr_options     how to lay out the graph for enumerating
 	 */
 	template <typename T>
-    static void enumerate(Graph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, const std::string& labelg_path)
+    static void enumerate(Graph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, const LabelGOptions& labelg_options, const CSROptions& csr_options = CSROptions{})
+	{
+		// every root walks the same snapshot
+		const CSRGraph csr(graph, csr_options);
+
+		enumerate<T>(csr, subgraphs, subgraphsize, probs, labelg_options);
+	} // end method enumerate(4)
+
+
+    /**
+	 * Enumerates all subgraphSize Subgraphs in a snapshot, which may have
+	 * been mapped from a file, using the RAND-ESU algorithm.
+	 *
+	 * @param graph           the CSR snapshot on which to execute RAND-ESU
+	 * @param subgraphSize    the size of the target Subgraphs
+	 */
+	template <typename T>
+    static void enumerate(const CSRGraph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, const LabelGOptions& labelg_options)
 	{
 		std::size_t numVerticesToSelect = probs[0] == 1.0 ? graph.getSize() : static_cast<std::size_t>(round(probs[0] * graph.getSize()));
 
@@ -77,7 +97,7 @@ public:
 
 		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "Creating nautylink ..." << std::endl;}
 
-		NautyLink nautylink(labelg_path, subgraphsize, graph.getEdges(), graph.isDirected());
+		NautyLink nautylink(labelg_options, subgraphsize, graph);
 
 		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "Enumerating ..." << std::endl;}
 
@@ -92,134 +112,46 @@ public:
 	 * Enumerates all subgraphSize Subgraphs for the specified vertice's branch
 	 * of an ESU execution tree using the RAND-ESU algorithm. Allows for more
 	 * control over execution order compared to the enumerate method that does
-	 * not include a vertex parameter.
-	 * @param graph the graph on which to execute RAND-ESU
+	 * not include a vertex parameter. The branch is walked by the engine of
+	 * the calling thread compiled for subgraphsize, whose buffers are reused
+	 * from branch to branch. Sizes 3 to 10 have an engine of their own,
+	 * others share the one sized at run time.
+	 * @param graph the CSR snapshot of the graph on which to execute RAND-ESU
 	 * @param subgraphs
 	 * @param subgraphSize
 	 * @param probs
 	 * @param vertex
      * @param nuatylink
+	 * @param splitter takes the subtrees given to idle workers, nullptr to
+	 *                 walk the whole branch on the calling thread
 	 */
 	template <typename T>
-    static void enumerate(Graph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, vertex vertexV, NautyLink& nautylink)
+    static void enumerate(const CSRGraph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, vertex vertexV, NautyLink& nautylink, ESUSplitter* splitter = nullptr)
 	{
-		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "In RandESU::numerate(bottom)" << std::endl;}
-
-		// create a subgraph with given subgraphsize
-		Subgraph subgraph(subgraphsize);
-
-		// create an extends
-		std::unordered_set<vertex> adjacencyList = graph.getAdjacencyList(vertexV);
-		std::vector<vertex> extends;
-		extends.reserve(adjacencyList.size());
-
-		std::copy_if(adjacencyList.begin(), adjacencyList.end(), std::back_inserter(extends), 
-			[&](auto& x) 
-			{ 
-				return x > vertexV; 
+		with_esu_engine(subgraphsize, [&](auto& r_engine)
+			{
+				r_engine.template enumerate<T>(graph, subgraphs, subgraphsize, probs, vertexV, nautylink, splitter);
 			} // end lambda
-		); // end copy_if
+		);
+	} // end method enumerate(7)
 
-		subgraph.add(vertexV); // add to the subgraph, the vertex and its corresponding adjacencylist
 
-		// randomly decide whether to extend
-		if (shouldExtend(probs[1])) 
-		{
-			//std::cerr << "Calling extend ..." << std::endl;
-			extend<T>(graph, subgraph, std::move(extends), probs, subgraphs, nautylink);
-		} // end if
-	} // end method enumerate(6)
-
-
-
-private:
-
-    /** determines whether or not to extend based on a given probability, given
-	 as an integer.
-	 precondition: 0.0 <= prob <= 1.0
-    **/
-    static bool shouldExtend(double prob)
-  	{
-  		assert(prob >= 0.0 && prob <= 1.0);
-
-  		return prob == 1.0 ? true : prob == 0.0 ? false : get_random_in_range(0, 100) <= (prob * 100.0);
-  	} // end method shouldExtend
-
-    /** returns true if the node index is exclusive to the given subgraph
-	 (that is, is not already in the subgraph, and is not adjacent to any of
-	  the nodes in the subgraph)
-     **/
-    static bool isExclusive(Graph& graph, vertex node, Subgraph& subgraph)
-  	{
-  		for (auto& element : subgraph)
-  		{
-  			if (element == node || graph.getAdjacencyList(element).count(node) > 0)
-  			{
-  				return false;
-  			} // end if
-  		} // end for element
-
-  		return true;
-  	} // end method isExclusive
-
-    /** extend the subgraphs recursively
-     **/
+    /**
+	 * Enumerates all subgraphSize Subgraphs of a part of a branch that the
+	 * engine walking the branch split off.
+	 * @param graph the CSR snapshot the branch was split from
+	 * @param subtree the part of the branch to walk
+	 * @param splitter takes the parts given away in turn, may be nullptr
+	 */
 	template <typename T>
-    static void extend(Graph& graph, Subgraph& subgraph, std::vector<vertex> extension, const std::vector<double>& probs, T* subgraphs, NautyLink& nautylink)
+    static void enumerate(const CSRGraph& graph, T* subgraphs, int subgraphsize, const std::vector<double>& probs, const ESUSubtree& subtree, NautyLink& nautylink, ESUSplitter* splitter = nullptr)
 	{
-		// optimize by not creating next extension if subgraph is
-		// 1 node away from completion
-		if (subgraph.getSize() == subgraph.getOrder() - 1) 
-		{
-			for(auto& element : extension)
+		with_esu_engine(subgraphsize, [&](auto& r_engine)
 			{
-				// check the last value in prob list
-				if (shouldExtend(probs.at(probs.size() - 1))) 
-				{
-					Subgraph subgraphUnion(subgraph);
-					subgraphUnion.add(element);
-					//std::cerr << "Calling subgraph->add ..." << std::endl;
-					subgraphs->add(subgraphUnion, nautylink);
-				} // end if
-			} // end for element
-		} // end if
-		else
-		{
-			//std::cerr << "In else of extend ..." << std::endl;
-
-			vertex v = subgraph.root();
-
-			// iterating over a vector and erasing items invalidates the iterator
-			// instead process first element until vector is empty
-			while (!extension.empty())
-			{
-				vertex w = extension[0];
-				extension.erase(extension.begin());
-
-				std::vector<vertex> nextExtension(extension);
-				std::unordered_set<vertex> adjW = graph.getAdjacencyList(w);
-
-				for(auto& u : adjW)
-				{
-					if (u > v && isExclusive(graph, u, subgraph))
-					{
-						nextExtension.push_back(u);
-					} // end if
-				} // end for u
-
-				// construct a union of w and the existing subgraph
-				Subgraph subgraphUnion(subgraph);
-				subgraphUnion.add(w);
-
-				// randomly choose whether or not to extend to the next level
-				// based on the probability vector provided.
-				if (shouldExtend(probs.at(subgraphUnion.getSize() - 1)))
-				{
-					extend<T>(graph, subgraphUnion, nextExtension, probs, subgraphs, nautylink);
-				} // end if
-			} // end while
-		} // end else
-	} // end method extend
+				r_engine.template enumerate<T>(graph, subgraphs, subgraphsize, probs, subtree, nautylink, splitter);
+			} // end lambda
+		);
+	} // end method enumerate(7)
 };
 
 #endif /* RANDESU_H */
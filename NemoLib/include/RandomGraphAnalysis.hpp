@@ -24,18 +24,20 @@
 
 #include "Config.hpp"
 #include "graph64.hpp"
+#include "MotifCode.hpp"
 #include <unordered_map>
 #include <vector>
 
 // forward declare type for references
 class Graph;
+struct LabelGOptions;
 
 class RandomGraphAnalysis
 {
 public:
     // not allowed 
     RandomGraphAnalysis(void) = delete;
-    static std::unordered_map<std::string, std::vector<double>> analyze(Graph&, int, int, const std::vector<double>&, const std::string&);
+    static std::unordered_map<MotifCode, std::vector<double>> analyze(Graph&, int, int, const std::vector<double>&, const LabelGOptions&);
 };
 
 #endif /* RANDOMGRAPHANALYSIS_H */
@@ -18,6 +18,7 @@
 
 #include "Config.hpp"
 #include "Graph.hpp"
+#include "CSRGraph.hpp"
 
 /**
   * Generates random graphs from an input graph based on the degree sequence of 
@@ -28,9 +29,12 @@ class RandomGraphGenerator
 {
 public:
     static Graph generate(const Graph&);
+    static Graph generate(const CSRGraph&);
     static Graph generate(const Graph&, const std::vector<int>&);
 
 private:
+    static Graph generateUndirected(const std::vector<int>&);
+    static Graph generateDirected(const std::vector<int>&, const std::vector<int>&);
     static std::vector<int> getDegreeSequenceVector(const Graph&);
 };
 
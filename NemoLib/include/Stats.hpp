@@ -5,6 +5,7 @@
 #include "Config.hpp"
 #include "graph64.hpp"
 #include "Utility.hpp"
+#include "MotifCode.hpp"
 #include <unordered_map>	// unordered_map
 #include <vector>			// vector
 #include <cmath>			// pow
@@ -15,13 +16,13 @@ namespace Statistical_Analysis
 {
 	// Forward declaration of namespace members:
 	struct stats_data;
-	std::unordered_map<std::string, double> getZScores(const stats_data& data);
-	std::unordered_map<std::string, double> getPValues(const stats_data& data);
-	double getPValue(const std::string& label, const stats_data& data);
-	double getZScore(const std::string& label, const double mean, const double stdDev, const stats_data& data);
-	double getZScore(const std::string& label, const stats_data& data);
-	double calcRandStdDev(const std::string& label, const double randMean, const stats_data& data);
-	double calcRandMean(const std::string& label, const stats_data& data);
+	std::unordered_map<MotifCode, double> getZScores(const stats_data& data);
+	std::unordered_map<MotifCode, double> getPValues(const stats_data& data);
+	double getPValue(const MotifCode label, const stats_data& data);
+	double getZScore(const MotifCode label, const double mean, const double stdDev, const stats_data& data);
+	double getZScore(const MotifCode label, const stats_data& data);
+	double calcRandStdDev(const MotifCode label, const double randMean, const stats_data& data);
+	double calcRandMean(const MotifCode label, const stats_data& data);
 
 
 	///<summary>
@@ -33,18 +34,18 @@ namespace Statistical_Analysis
 	///</remarks>
 	struct stats_data
 	{
-		stats_data(std::unordered_map<std::string, double>* target_, std::unordered_map<std::string, std::vector<double>>* random_, const std::size_t count_)
+		stats_data(std::unordered_map<MotifCode, double>* target_, std::unordered_map<MotifCode, std::vector<double>>* random_, const std::size_t count_)
 			: targetGraphRelFreqs{ target_ }, randomGraphRelFreqs{ random_ }, randGraphCount{count_} {}
 
 		///<summary>
 		/// Relative frequencies in the target graph.
 		///</summary>
-		std::unordered_map<std::string, double>* targetGraphRelFreqs;
+		std::unordered_map<MotifCode, double>* targetGraphRelFreqs;
 
 		///<summary>
 		/// Relative frequencies in the randomly generated graph(s).
 		///</summary>
-		std::unordered_map<std::string, std::vector<double>>* randomGraphRelFreqs;
+		std::unordered_map<MotifCode, std::vector<double>>* randomGraphRelFreqs;
 
 		///<summary>
 		/// Number of randomly generated graphs used to find <see cref="Statistical_Analysis::stats_data::randomGraphRelFreqs"/>.
@@ -58,9 +59,9 @@ namespace Statistical_Analysis
 	///</summary>
 	///<param name="data"><see cref="Statistical_Analysis::stats_data"/> object with statistical data for z-score calculations.</param>
 	///<returns>A map of {label : z-score} pairs.</returns>
-	std::unordered_map<std::string, double> getZScores(const stats_data& data)
+	std::unordered_map<MotifCode, double> getZScores(const stats_data& data)
 	{
-		std::unordered_map<std::string, double> zScores(data.randomGraphRelFreqs->size());
+		std::unordered_map<MotifCode, double> zScores(data.randomGraphRelFreqs->size());
 
 		for (auto& p : *(data.randomGraphRelFreqs))
 		{
@@ -79,9 +80,9 @@ namespace Statistical_Analysis
 	///</summary>
 	///<param name="data"><see cref="Statistical_Analysis::stats_data"/> object with statistical data for p-value calculations.</param>
 	///<returns>A map of {label : p-value} pairs.</returns>
-	std::unordered_map<std::string, double> getPValues(const stats_data& data)
+	std::unordered_map<MotifCode, double> getPValues(const stats_data& data)
 	{
-		std::unordered_map<std::string, double>  pValues(data.randomGraphRelFreqs->size());
+		std::unordered_map<MotifCode, double>  pValues(data.randomGraphRelFreqs->size());
 		for (auto& p : *(data.randomGraphRelFreqs))
 		{
 			pValues[p.first] = getPValue(p.first, data);
@@ -100,7 +101,7 @@ namespace Statistical_Analysis
 	/// 2) 1 if the motif never occurred in the target graph;
 	/// 3) a value in the range (0,1) representing the p-value of the given motif.
 	///</returns>
-	double getPValue(const std::string& label, const stats_data& data)
+	double getPValue(const MotifCode label, const stats_data& data)
 	{
 		// if a label appears in the target graph that didn't show up in any
 		// random graphs, clearly it's a network motif. This scenario shouldn't
@@ -139,7 +140,7 @@ namespace Statistical_Analysis
 	/// 1) 0 if the <paramref name="stdDev"/> is 0;
 	/// 2) The z-score associated with the motif-candidate <paramref name="label"/>.
 	///</returns>
-	double getZScore(const std::string& label, const double mean, const double stdDev, const stats_data& data)
+	double getZScore(const MotifCode label, const double mean, const double stdDev, const stats_data& data)
 	{
 		double targetGraphFreq = data.targetGraphRelFreqs->count(label) == 0 ? 0.0 : data.targetGraphRelFreqs->at(label);
 		return (stdDev == 0 ? 0.0 : (targetGraphFreq - mean) / stdDev);
@@ -155,7 +156,7 @@ namespace Statistical_Analysis
 	/// 1) 0 if the calculated standard deviation is 0;
 	/// 2) The z-score associated with the motif-candidate <paramref name="label"/>.
 	///</returns>
-	double getZScore(const std::string& label, const stats_data& data)
+	double getZScore(const MotifCode label, const stats_data& data)
 	{
 		double randMean = calcRandMean(label, data);
 		return getZScore(label, randMean, calcRandStdDev(label, randMean, data), data);
@@ -172,7 +173,7 @@ namespace Statistical_Analysis
 	/// 1) 0 if the calculated standard deviation is 0;
 	/// 2) The z-score associated with the motif-candidate <paramref name="label"/>.
 	///</returns>
-	double calcRandStdDev(const std::string& label, const double randMean, const stats_data& data)
+	double calcRandStdDev(const MotifCode label, const double randMean, const stats_data& data)
 	{
 		double variance = get_vector_sum(data.randomGraphRelFreqs->at(label).begin(), data.randomGraphRelFreqs->at(label).end(), 0.0,
 			[&](auto prev, auto cur) { return prev + std::pow((cur - randMean), 2); });
@@ -189,7 +190,7 @@ namespace Statistical_Analysis
 	///<returns>
 	/// The random mean associated with the motif-candidate <paramref name="label"/>.
 	///</returns>
-	double calcRandMean(const std::string& label, const stats_data& data)
+	double calcRandMean(const MotifCode label, const stats_data& data)
 	{
 		std::vector<double>* relFreqs = &data.randomGraphRelFreqs->at(label);
 
@@ -207,7 +208,7 @@ namespace Statistical_Analysis
 		for (auto& p : *(stats.randomGraphRelFreqs))
 		{
 			auto& label = p.first;
-			out << label << "\t";
+			out << Motif_Code::to_g6(label) << "\t";
 			if ((*(stats.targetGraphRelFreqs)).count(label) > 0)
 			{
 				out << std::fixed << stats.targetGraphRelFreqs->at(label) * 100.0;
@@ -88,7 +88,8 @@ public:
 	{
 		order = OTHER.order;
 		current = OTHER.current;
-		nodes = std::vector<vertex>(OTHER.nodes);
+		// reuses the storage of nodes when it is large enough
+		nodes = OTHER.nodes;
 
 		return *this;
 	} // end Copy Assignment
@@ -135,6 +136,20 @@ public:
 	} // end method add
 
 
+	// removes the last element added, the storage is kept
+	inline void pop(void)
+	{
+		current--;
+	} // end method pop
+
+
+	// removes every element, the storage is kept
+	inline void clear(void)
+	{
+		current = 0;
+	} // end method clear
+
+
 	// to avoid signed -> unsigned truncation errors,
 	// we cannot return a sentinel value in this function
 	inline vertex get(std::size_t n) const
@@ -149,6 +164,12 @@ public:
 	} // end method getNodes
 
 
+	inline const vertex* data(void) const
+	{
+		return nodes.data();
+	} // end method data
+
+
 	// to avoid signed -> unsigned truncation errors,
 	// we cannot return a sentinel value in this function
 	// get the first vertex id added to this subgraph
@@ -11,6 +11,7 @@
 #include <iterator>           // make_move_iterator
 
 #include "Subgraph.hpp"       // Subgraph
+#include "InlineSubgraph.hpp" // InlineSubgraph
 #include "NautyLink.hpp"      // NautyLink
 #include "SubgraphCount.hpp"  // SubgraphCount
 #include "Stats.hpp"          // stats_data, getPValue
@@ -101,7 +102,7 @@ public:
         //put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCollection::add " << std::endl;
         // {Logger() << "[Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCollection::add " << std::endl;}
         
-        std::string label = nautylink.nautylabel_helper(currentSubgraph);
+        const MotifCode label = nautylink.nautylabel_helper(currentSubgraph);
 
         //put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "Got label: " << label << std::endl;
         // {Logger() << "[Thread: " << std::this_thread::get_id() << "]: " <<"Got label: " << label << std::endl;}
@@ -114,18 +115,57 @@ public:
         if (true == m_b_generate_subgraph_collection)
         {
             std::lock_guard<std::mutex> guard(m_mtx_write_subgraph_q);
-    		m_queue_write_subgraph.push(std::string{label + "\n" + static_cast<std::string>(currentSubgraph) + "\n"});
+    		m_queue_write_subgraph.push(std::string{Motif_Code::to_g6(label) + "\n" + static_cast<std::string>(currentSubgraph) + "\n"});
         } // end if
 	} // end method add
 
 
-    void add_label2Subgraph(const std::string& label, const Subgraph& currentSubgraph)
+	/** @brief Adds a batch of subgraphs, labeling them together and taking each lock once. 
+      * @param subgraphs The subgraphs to add to the collection
+      * @param nautylink Object used for getting the canonical labels of subgraphs
+      */
+	void add_batch(std::vector<InlineSubgraph>& subgraphs, NautyLink& nautylink) override
+	{
+        std::vector<MotifCode> labels;
+        nautylink.nautylabel_batch(subgraphs, labels);
+
+        { // lock_guard scope
+            std::lock_guard<std::mutex> guard(m_mtx_label_frq_map);
+
+            for (const MotifCode label : labels)
+            {
+                labelFreqMap[label] += 1;
+            } // end for label
+        } // end lock_guard
+
+        { // lock_guard scope
+            std::lock_guard<std::mutex> guard(m_mtx_label_subgraph_map);
+
+            for (std::size_t i{0}; i < subgraphs.size(); i++)
+            {
+                labelToSubgraph[labels[i]].push_back(subgraphs[i]);
+            } // end for i
+        } // end lock_guard
+
+        if (true == m_b_generate_subgraph_collection)
+        {
+            std::lock_guard<std::mutex> guard(m_mtx_write_subgraph_q);
+
+            for (std::size_t i{0}; i < subgraphs.size(); i++)
+            {
+                m_queue_write_subgraph.push(std::string{Motif_Code::to_g6(labels[i]) + "\n" + static_cast<std::string>(subgraphs[i]) + "\n"});
+            } // end for i
+        } // end if
+	} // end method add_batch
+
+
+    void add_label2Subgraph(const MotifCode label, const Subgraph& currentSubgraph)
     { 
         std::lock_guard<std::mutex> my_guard(m_mtx_label_subgraph_map);
         //put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "Aquried labelToSubgraph lock, current size: " << labelToSubgraph.size() << std::endl;
         //{Logger() << "[Thread: " << std::this_thread::get_id() << "]: " << "Aquried labelToSubgraph lock, current size: " << labelToSubgraph.size() << std::endl;}
 
-        labelToSubgraph[label].push_back(currentSubgraph);
+        labelToSubgraph[label].emplace_back(currentSubgraph);
 
         //put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "labelToSubgraph size after adding: " << labelToSubgraph.size() << std::endl;
         //{Logger() << "[Thread: " << std::this_thread::get_id() << "]: " << "labelToSubgraph size after adding: " << labelToSubgraph.size() << std::endl;}
@@ -152,11 +192,13 @@ public:
                 //put_time_stamp(std::cerr) << "The label " << p.first << " has p value less than or equal to 0.05" << std::endl;
                 //put_time_stamp(std::cerr) << "Adding " << p.second.size() << " motifs to queue" << std::endl;
 
+                const std::string str_label = Motif_Code::to_g6(p.first);
+
                 std::lock_guard<std::mutex> guard(m_mtx_write_nemo_q);
 
 				for (const auto& q : p.second)
 				{
-                    m_queue_write_nemo.push(std::string{p.first + "\n" + static_cast<std::string>(q) + "\n"});
+                    m_queue_write_nemo.push(std::string{str_label + "\n" + static_cast<std::string>(q) + "\n"});
 				} // end for q
 			} // end if
 		} // end for p
@@ -345,8 +387,9 @@ protected:
     //! buffer for network motifs to be written to the file
     std::queue<std::string> m_queue_write_nemo;       
 
-    //! stores each motif label with all instances of that motif
-	std::unordered_map<std::string, std::vector<Subgraph>> labelToSubgraph; 
+    //! stores each motif label with all instances of that motif, inline
+    //! so that the instances take no allocation of their own
+	std::unordered_map<MotifCode, std::vector<InlineSubgraph>> labelToSubgraph; 
 }; // end class SubgraphCollection
 
 #endif /* __NEMOLIB_SUBGRAPH_COLLECTION_HPP */
\ No newline at end of file
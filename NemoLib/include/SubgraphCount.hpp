@@ -60,9 +60,9 @@ public:
 	} // end Move Assignment
 
 
-	virtual std::unordered_map<std::string, double> getRelativeFrequencies() const
+	virtual std::unordered_map<MotifCode, double> getRelativeFrequencies() const
 	{
-		std::unordered_map<std::string, double> result_map(labelFreqMap.size());
+		std::unordered_map<MotifCode, double> result_map(labelFreqMap.size());
 		uint64_t totalSubgraphCount = 0;
 
 		for (const auto& p : labelFreqMap)
@@ -86,13 +86,12 @@ public:
 		//put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(2)" << std::endl;
 		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(2)" << std::endl;}
 		
-		std::string label{std::move(nautylink.nautylabel_helper(currentSubgraph))};
-		add(currentSubgraph, nautylink, label);
+		add(currentSubgraph, nautylink, nautylink.nautylabel_helper(currentSubgraph));
 	} // end method add(2)
 
 
 	/* Implement the add function of subgraph enumeration result*/
-	virtual void add(Subgraph& currentSubgraph, NautyLink& nautylink, const std::string& label)
+	virtual void add(Subgraph& currentSubgraph, NautyLink& nautylink, const MotifCode label)
 	{
 		//put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), aquiring lock ..." << std::endl;
 		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), aquiring lock ..." << std::endl;}
@@ -100,26 +99,34 @@ public:
 		//put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), aquired lock" << std::endl;
 		//{Logger()  << "[Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), aquired lock" << std::endl;}
 
-		if (1 == labelFreqMap.count(label))
-		{
-			labelFreqMap[label] += 1;
-		} // end if
-		else
-		{
-			labelFreqMap[label] = 1;
-		} // end else
+		labelFreqMap[label] += 1;
 		//put_time_stamp(std::cerr) << " [Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), releasing lock ..." << std::endl;
 		//{Logger() << "[Thread: " << std::this_thread::get_id() << "]: " << "In SubgraphCount::add(3), releasing lock ..." << std::endl;}
 	} // end method add(3)
 
 
-	inline std::unordered_map<std::string, uint64_t> getlabelFreqMap() const
+	/* Labels the whole batch at once and takes the lock a single time*/
+	virtual void add_batch(std::vector<InlineSubgraph>& subgraphs, NautyLink& nautylink)
+	{
+		std::vector<MotifCode> labels;
+		nautylink.nautylabel_batch(subgraphs, labels);
+
+		std::lock_guard<std::mutex> guard(m_mtx_label_frq_map);
+
+		for (const MotifCode label : labels)
+		{
+			labelFreqMap[label] += 1;
+		} // end for label
+	} // end method add_batch
+
+
+	inline std::unordered_map<MotifCode, uint64_t> getlabelFreqMap() const
 	{
 		return labelFreqMap;
 	}
 
 
-	inline std::unordered_map<std::string, uint64_t>* getLabelFreqMapAccess()
+	inline std::unordered_map<MotifCode, uint64_t>* getLabelFreqMapAccess()
 	{
 		return &labelFreqMap;
 	}
@@ -160,12 +167,12 @@ public:
 	{
 		for (const auto& x : labelFreqMap)
 		{
-			std::cout << x.first << " -> " << x.second << std::endl;
+			std::cout << Motif_Code::to_g6(x.first) << " -> " << x.second << std::endl;
 		}
 	}
 
 protected:
-	std::unordered_map<std::string, uint64_t> labelFreqMap;
+	std::unordered_map<MotifCode, uint64_t> labelFreqMap;
 	std::mutex m_mtx_label_frq_map;
 };
 
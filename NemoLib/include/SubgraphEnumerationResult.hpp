@@ -16,13 +16,15 @@
 /*This class is an interface class*/
 
 #include <unordered_map>
-#include <string>
+#include <vector>
 
 #include "Config.hpp"
 #include "graph64.hpp"
+#include "MotifCode.hpp"
+#include "Subgraph.hpp"
+#include "InlineSubgraph.hpp"
 
 // forward declare types for references below
-class Subgraph;
 class NautyLink;
 
 class SubgraphEnumerationResult
@@ -41,12 +43,27 @@ public:
 	 */
     virtual void add(Subgraph&, NautyLink&) = 0;
 
+    /**
+	 * Adds a batch of Subgraphs to this SubgraphEnumerationResult. Results
+	 * that can label a whole batch at once should override this, the
+	 * default converts the Subgraphs and adds them one by one.
+	 * @param subgraphs the Subgraphs to add
+	 */
+    virtual void add_batch(std::vector<InlineSubgraph>& subgraphs, NautyLink& nautylink)
+	{
+		for (const InlineSubgraph& subgraph : subgraphs)
+		{
+			Subgraph legacy = static_cast<Subgraph>(subgraph);
+			add(legacy, nautylink);
+		} // end for subgraph
+	} // end method add_batch
+
     /**
 	 * Calculates and returns a map of relative frequencies or concentrations
 	 * of labels in this subgraph.
 	 * @return The map of relative frequencies
 	 */
-    virtual std::unordered_map <std::string, double> getRelativeFrequencies(void) const = 0;
+    virtual std::unordered_map <MotifCode, double> getRelativeFrequencies(void) const = 0;
 };
 
 #endif /* SUBGRAPHENUMERATIONRESULT_H */
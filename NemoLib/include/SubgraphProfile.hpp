@@ -34,17 +34,18 @@ public:
 	SubgraphProfile(uint64_t size) : graphsize(size) {}
     virtual ~SubgraphProfile() = default;
     virtual void add(Subgraph&, NautyLink&);
+    virtual void add_batch(std::vector<InlineSubgraph>&, NautyLink&) override;
 
-	std::unordered_map<std::string, uint64_t> getlabelFreqMap(int); //need subgraphsize to calculate frequency
-	std::unordered_map <std::string, double> getRelativeFrequencies() const;
+	std::unordered_map<MotifCode, uint64_t> getlabelFreqMap(int); //need subgraphsize to calculate frequency
+	std::unordered_map <MotifCode, double> getRelativeFrequencies() const;
 
-	inline std::unordered_map<std::string, std::vector<uint64_t>> getlabelVertexFreqMapMap()
+	inline std::unordered_map<MotifCode, std::vector<uint64_t>> getlabelVertexFreqMapMap()
 	{
 		return labelVertexFreqMapMap;
 	}
 
 private:
-	std::unordered_map<std::string, std::vector<uint64_t>> labelVertexFreqMapMap;
+	std::unordered_map<MotifCode, std::vector<uint64_t>> labelVertexFreqMapMap;
 	uint64_t graphsize;
 
 	inline uint64_t getTotalSubgaphCount(void) const
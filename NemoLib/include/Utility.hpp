@@ -4,11 +4,16 @@
 #define __UTIL_HPP
 
 #include "Config.hpp" // _C17_EXECUTION_AVAILABLE
+#include "MotifCode.hpp" // Motif_Code
 #include <random>     // random_device, mt19937, uniform_int_distribution, uniform_real_distribution
 #include <numeric>    // accumulate
 #include <chrono>     // high_resolution_clock, duration_cast
 #include <ctime>      // localtime
 #include <iomanip>    // put_time
+#include <iostream>   // cerr
+#include <string>     // string
+#include <algorithm>  // copy, find
+#include <initializer_list> // initializer_list
 
 
 // Typedefs to make the clock and timepoint names shorter
@@ -90,4 +95,81 @@ inline void log_message(std::ostream& out, const std::string& msg)
 } // end method log_message
 
 
+// looks for "NAME=VALUE" or "NAME VALUE" in argv and removes it, so that
+// the remaining positional arguments keep their usual indices
+inline bool extract_option(int& argc, char** argv, const std::string& kr_str_NAME_, std::string& str_value)
+{
+	const std::string k_str_PREFIX{kr_str_NAME_ + "="};
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string k_str_ARG{argv[i]};
+		int i_consumed = 0;
+
+		if (0 == k_str_ARG.compare(0, k_str_PREFIX.size(), k_str_PREFIX))
+		{
+			str_value = k_str_ARG.substr(k_str_PREFIX.size());
+			i_consumed = 1;
+		} // end if
+		else if (k_str_ARG == kr_str_NAME_ && i + 1 < argc)
+		{
+			str_value = argv[i + 1];
+			i_consumed = 2;
+		} // end elif
+
+		if (i_consumed > 0)
+		{
+			// argv[argc] is the terminating nullptr, move it as well
+			std::copy(argv + i + i_consumed, argv + argc + 1, argv + i);
+			argc -= i_consumed;
+			return true;
+		} // end if
+	} // end for i
+
+	return false;
+} // end method extract_option
+
+
+// looks for any of the given flags in argv and removes them, like extract_option
+inline bool extract_flag(int& argc, char** argv, std::initializer_list<std::string> names)
+{
+	bool b_found = false;
+
+	for (int i = 1; i < argc; )
+	{
+		if (std::find(names.begin(), names.end(), argv[i]) == names.end())
+		{
+			i++;
+			continue;
+		} // end if
+
+		// argv[argc] is the terminating nullptr, move it as well
+		std::copy(argv + i + 1, argv + argc + 1, argv + i);
+		argc -= 1;
+		b_found = true;
+	} // end for i
+
+	return b_found;
+} // end method extract_flag
+
+
+// motifs are stored in 64-bit codes and a size atoi couldn't parse reads
+// as 0, a size that doesn't fit is turned down here rather than from
+// inside the enumeration
+inline bool check_motif_size(const std::size_t motifSize, const bool directed)
+{
+	constexpr std::size_t ku_li_MIN_SIZE = 3;
+
+	if (motifSize >= ku_li_MIN_SIZE && true == Motif_Code::fits(motifSize, directed))
+	{
+		return true;
+	} // end if
+
+	std::cerr << "Motif size " << motifSize << " is not supported for a" << (directed ? " directed" : "n undirected") << " graph, it must be from "
+	          << ku_li_MIN_SIZE << " to " << (directed ? Motif_Code::ku_li_MAX_DIRECTED : Motif_Code::ku_li_MAX_UNDIRECTED) << std::endl;
+
+	return false;
+} // end method check_motif_size
+
+
 #endif
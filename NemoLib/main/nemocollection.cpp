@@ -3,6 +3,8 @@
 #include "Graph.hpp"
 #include "SubgraphCollection.hpp"
 #include "Stats.hpp"
+#include "LabelCache.hpp"
+#include "CSRGraph.hpp"
 
 #include "loguru.hpp"
 
@@ -37,20 +39,52 @@ void display_help(const string& kr_str_NAME_)
 	std::cout << std::endl;
 	std::cout << "Options:" << std::endl;
 	std::cout << "\t[-v VERBOSITY]    -- set the logging verbosity level. Integer in range [0,4]." << std::endl;
+	std::cout << "\t[--labelg-processes N] -- keep N labelg processes running instead of starting one per label." << std::endl;
+	std::cout << "\t[--labelg-workers N]   -- label with N worker threads sharing the labels by hash (ignored with --labelg-processes)." << std::endl;
+	std::cout << "\t                         ignored by the built-in nauty labeler, it labels on the enumerating threads, in parallel only if built with -Dnauty_tls=true." << std::endl;
+	std::cout << "\t[--label-cache PATH]  -- load cannonical labels from PATH before labeling and merge the new ones into it at the end." << std::endl;
+	std::cout << "\t[-d | --directed]     -- read the edges of an edge list as directed, from the first vertex to the second (digraph6 always is)." << std::endl;
+	std::cout << "\t[--order ORDER]       -- renumber vertices before enumerating: none (default), degree, degeneracy or rcm." << std::endl;
+	std::cout << "\t[--dense-adjacency M] -- test edges in a bit matrix: auto (default, small graphs only), on or off." << std::endl;
+	std::cout << "\t[--shuffle MODE]      -- number vertices in a shuffled edge order: on (default, a random seed), off or a seed." << std::endl;
+	std::cout << "\t[--ids MODE]          -- read vertex names as integers or strings: auto (default, integers if all are), numeric or names." << std::endl;
 	std::cout << "\t[-h | --help]     -- use instead of [file path] to display this help menu." << std::endl;
 	std::cout << std::endl;
 	std::cout << "Positional :" << std::endl;
-	std::cout << "\t[file path]       -- complete or relative path to graph (g6 or d6 formatted) file." << std::endl;
+	std::cout << "\t[file path]       -- complete or relative path to an edge list, a graph6, sparse6 or digraph6 file, or a snapshot written by nemoconvert." << std::endl;
 	std::cout << "\t[# threads]       -- number of threads to use (Note that Nemolib uses 2 additional threads)." << std::endl;
-	std::cout << "\t[motif size]      -- size of motif to search for." << std::endl;
+	std::cout << "\t[motif size]      -- size of motif to search for, from 3 to 11, or to 8 if the graph is directed." << std::endl;
 	std::cout << "\t[# random graphs] -- number of random graphs to use for ESU." << std::endl;
-	std::cout << "\t[labelg path]     -- path to the special labelg binary." << std::endl;
+	std::cout << "\t[labelg path]     -- path to the special labelg binary (\"\" to use the built-in nauty labeler)." << std::endl;
 	std::cout << "\t[output path]     -- path where to store the nemo collection." << std::endl;
 } // end method display_help
 
 
 int main(int argc, char** argv)
 {
+	string str_option;
+
+	// options are removed from argv so positional arguments keep their index
+	const std::size_t n_labelg_procs = extract_option(argc, argv, "--labelg-processes", str_option) ? std::stoul(str_option) : 0;
+	const std::size_t n_labelg_workers = extract_option(argc, argv, "--labelg-workers", str_option) ? std::stoul(str_option) : 0;
+	const string label_cache_path = extract_option(argc, argv, "--label-cache", str_option) ? str_option : "";
+	const bool directed = extract_flag(argc, argv, {"-d", "--directed"});
+	const VertexOrder vertex_order = parse_vertex_order(extract_option(argc, argv, "--order", str_option) ? str_option : "none");
+	const DenseAdjacency dense_adjacency = parse_dense_adjacency(extract_option(argc, argv, "--dense-adjacency", str_option) ? str_option : "auto");
+	const CSROptions csr_options{vertex_order, dense_adjacency};
+
+	ParseOptions parse_options;
+
+	if (true == extract_option(argc, argv, "--shuffle", str_option))
+	{
+		parse_shuffle(str_option, parse_options);
+	} // end if
+
+	if (true == extract_option(argc, argv, "--ids", str_option))
+	{
+		parse_options.m_ids = parse_vertex_ids(str_option);
+	} // end if
+
     // check if user wants to see the help
     // or if they gave too many parameters
 	if(argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help"))
@@ -70,14 +104,38 @@ int main(int argc, char** argv)
     // -v option can be used to change verbosity
     loguru::init(argc, argv);
 
+	// a warm cache spares most calls to the labeler
+	std::size_t n_cache_skipped = 0;
+
+	if (false == label_cache_path.empty() && true == LabelCache::instance().load(label_cache_path, &n_cache_skipped))
+	{
+		LOG_F(INFO, "Loaded %zu cannonical labels from %s", LabelCache::instance().size(), label_cache_path.c_str());
+
+		if (n_cache_skipped > 0)
+		{
+			LOG_F(WARNING, "Skipped %zu labels of %s whose size or directedness is wrong, they will be relabeled", n_cache_skipped, label_cache_path.c_str());
+		} // end if
+	} // end if
+
     // get parameters or use default values
 	const string      filename    = argc > 1 ?      argv[1]  : "./test/exampleGraph.txt";
 	const std::size_t n_threads   = argc > 2 ? atoi(argv[2]) : 14;
 	const std::size_t motifSize   = argc > 3 ? atoi(argv[3]) : 3;
 	const std::size_t randomCount = argc > 4 ? atoi(argv[4]) : 1000;
-	const string      labelg_path = argc > 5 ?      argv[5]  : "./labelg";
+	const string      labelg_path = argc > 5 ?      argv[5]  : (_USE_NAUTY ? "" : "./labelg");
 	const string      nemoc_path  = argc > 6 ?      argv[6]  : "./test/nemocollection.txt";
 
+	if (false == check_motif_size(motifSize, directed))
+	{
+		display_help(argv[0]);
+		return 1;
+	} // end if
+
+	// the edge list is parsed on as many threads as the enumeration
+	parse_options.mu_li_threads = n_threads;
+
+	const LabelGOptions labelg_options{labelg_path, n_labelg_procs, n_labelg_workers};
+
     auto subc = std::make_unique<SubgraphCollection>(false);
 
 	vector<double> probs(motifSize - 2, 1.0);
@@ -94,19 +152,25 @@ int main(int argc, char** argv)
 
     LOG_F(INFO, "Reading in the graph in file %s", filename.c_str());
 
-    // read in the given graph as undirected 
-	Graph targetg(filename, false);
+    // read in the given graph, directed if requested 
+	const CSRGraph targetg = read_graph(filename, directed, parse_options, csr_options);
+
+	// digraph6 files and snapshots are directed without -d
+	if (false == check_motif_size(motifSize, targetg.isDirected()))
+	{
+		return 1;
+	} // end if
 
 	LOG_F(INFO, "Enumerating graph ...");
 
-	ESU_Parallel::enumerate<SubgraphCollection>(targetg, subc.get(), static_cast<int>(motifSize), &my_pool, labelg_path);
-	unordered_map<std::string, double> targetLabelRelFreqMap(std::move(subc->getRelativeFrequencies()));
+	ESU_Parallel::enumerate<SubgraphCollection>(targetg, subc.get(), static_cast<int>(motifSize), &my_pool, labelg_options);
+	unordered_map<MotifCode, double> targetLabelRelFreqMap(std::move(subc->getRelativeFrequencies()));
 
 	LOG_F(INFO, "Analyzing random graphs...");
 
 	Parallel_Analysis::AnalyzeArgPack analyze_args
 	(
-		&targetg, randomCount, motifSize, probs, &my_pool, labelg_path
+		&targetg, randomCount, motifSize, probs, &my_pool, labelg_options, csr_options
 	);
 
 	auto randLabelRelFreqsMap = std::move(Parallel_Analysis::analyze(analyze_args));
@@ -114,6 +178,11 @@ int main(int argc, char** argv)
 	// alert all threads to terminate to save resources
 	my_pool.Kill_All();
 
+	if (false == label_cache_path.empty())
+	{
+		LabelCache::instance().save(label_cache_path);
+	} // end if
+
 	LOG_F(INFO, "Comparing target graph to random graphs ... ");
 
 	Statistical_Analysis::stats_data data{&targetLabelRelFreqMap, &randLabelRelFreqsMap, randomCount};
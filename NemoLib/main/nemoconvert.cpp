@@ -0,0 +1,83 @@
+#include "Config.hpp"
+#include "Utility.hpp"
+#include "EdgeListReader.hpp"
+#include "CSRGraph.hpp"
+
+#include "loguru.hpp"
+
+#include <chrono>
+#include <string>
+#include <iostream>
+
+
+using std::string;
+using std::chrono::milliseconds;
+
+
+void display_help(const string& kr_str_NAME_)
+{
+	std::cout << "Usage:" << std::endl;
+	std::cout << "\t" << kr_str_NAME_ << " [options] [file path] [snapshot path]" << std::endl;
+	std::cout << "\t\t[file path]       -- complete or relative path to the edge list, graph6, sparse6 or digraph6 file to convert." << std::endl;
+	std::cout << "\t\t[snapshot path]   -- where to write the binary snapshot that nemolib and nemocollection can map." << std::endl;
+	std::cout << "\t\t[-h | --help]     -- use instead of [file path] to display this help menu." << std::endl;
+	std::cout << "\t" << "Options:" << std::endl;
+	std::cout << "\t\t[-d | --directed]     -- read the edges of an edge list as directed, from the first vertex to the second (digraph6 always is)." << std::endl;
+	std::cout << "\t\t[--order ORDER]       -- renumber vertices in the snapshot: none (default), degree, degeneracy or rcm." << std::endl;
+	std::cout << "\t\t[--shuffle MODE]      -- number vertices in a shuffled edge order: on (default, a random seed), off or a seed." << std::endl;
+	std::cout << "\t\t[--ids MODE]          -- read vertex names as integers or strings: auto (default, integers if all are), numeric or names." << std::endl;
+	std::cout << "\t\t[--threads N]         -- parse the edge list on N threads (default: one per core)." << std::endl;
+} // end method display_help
+
+
+int main(int argc, char** argv)
+{
+	string str_option;
+
+	const bool directed = extract_flag(argc, argv, {"-d", "--directed"});
+	const VertexOrder vertex_order = parse_vertex_order(extract_option(argc, argv, "--order", str_option) ? str_option : "none");
+
+	ParseOptions parse_options(extract_option(argc, argv, "--threads", str_option) ? std::stoul(str_option) : 0);
+
+	if (true == extract_option(argc, argv, "--shuffle", str_option))
+	{
+		parse_shuffle(str_option, parse_options);
+	} // end if
+
+	if (true == extract_option(argc, argv, "--ids", str_option))
+	{
+		parse_options.m_ids = parse_vertex_ids(str_option);
+	} // end if
+
+	const bool help = argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help");
+
+	if (true == help || argc != 3)
+	{
+		display_help(argv[0]);
+		return false == help;
+	} // end if
+
+	loguru::init(argc, argv);
+
+	const string filename = argv[1];
+	const string snapshot_path = argv[2];
+
+	auto begin = _Clock::now();
+
+	LOG_F(INFO, "Reading in the graph in file %s", filename.c_str());
+
+	const EdgeList edges = read_edge_list(filename, directed, parse_options);
+
+	// the bit matrix and hub bitsets are rebuilt when mapping
+	const CSRGraph snapshot(edges, CSROptions{vertex_order, DenseAdjacency::OFF});
+
+	LOG_F(INFO, "Writing %zu vertices and %zu edges to %s", snapshot.getSize(), snapshot.getEdgeCount(), snapshot_path.c_str());
+
+	snapshot.save(snapshot_path, vertex_names(edges));
+
+	auto end = _Clock::now();
+
+	LOG_F(INFO, "Time = %.4f milliseconds", chrono_duration<milliseconds>(begin, end));
+
+	return (EXIT_SUCCESS);
+} // end Main
@@ -4,6 +4,8 @@
 #include "SubgraphCount.hpp"
 #include "SubgraphProfile.hpp"
 #include "Stats.hpp"
+#include "LabelCache.hpp"
+#include "CSRGraph.hpp"
 #include <chrono>
 #include <string>
 #include <iostream>
@@ -27,18 +29,50 @@ using std::chrono::milliseconds;
 void display_help(string _name)
 {
 	std::cout << "Usage:" << std::endl;
-	std::cout << "\t" << _name << " [file path] [# threads] [motif size] [# random graphs] [labelg path]" << std::endl;
-	std::cout << "\t\t[file path]       -- complete or relative path to graph (g6 or d6 formatted) file." << std::endl;
+	std::cout << "\t" << _name << " [options] [file path] [# threads] [motif size] [# random graphs] [labelg path]" << std::endl;
+	std::cout << "\t\t[file path]       -- complete or relative path to an edge list, a graph6, sparse6 or digraph6 file, or a snapshot written by nemoconvert." << std::endl;
 	std::cout << "\t\t[# threads]       -- number of threads to use (ignored for sequential nemolib)." << std::endl;
-	std::cout << "\t\t[motif size]      -- size of motif to search for." << std::endl;
+	std::cout << "\t\t[motif size]      -- size of motif to search for, from 3 to 11, or to 8 if the graph is directed." << std::endl;
 	std::cout << "\t\t[# random graphs] -- number of random graphs to use for ESU." << std::endl;
-	std::cout << "\t\t[labelg path]     -- path to the labelg program to use." << std::endl;
+	std::cout << "\t\t[labelg path]     -- path to the labelg program to use (omit to use the built-in nauty labeler)." << std::endl;
 	std::cout << "\t\t[-h | --help]     -- use instead of [file path] to display this help menu." << std::endl;
+	std::cout << "\t" << "Options:" << std::endl;
+	std::cout << "\t\t[--labelg-processes N] -- keep N labelg processes running instead of starting one per label." << std::endl;
+	std::cout << "\t\t[--labelg-workers N]   -- label with N worker threads sharing the labels by hash (ignored with --labelg-processes)." << std::endl;
+	std::cout << "\t\t                         ignored by the built-in nauty labeler, it labels on the enumerating threads, in parallel only if built with -Dnauty_tls=true." << std::endl;
+	std::cout << "\t\t[--label-cache PATH]  -- load cannonical labels from PATH before labeling and merge the new ones into it at the end." << std::endl;
+	std::cout << "\t\t[-d | --directed]     -- read the edges of an edge list as directed, from the first vertex to the second (digraph6 always is)." << std::endl;
+	std::cout << "\t\t[--order ORDER]       -- renumber vertices before enumerating: none (default), degree, degeneracy or rcm." << std::endl;
+	std::cout << "\t\t[--dense-adjacency M] -- test edges in a bit matrix: auto (default, small graphs only), on or off." << std::endl;
+	std::cout << "\t\t[--shuffle MODE]      -- number vertices in a shuffled edge order: on (default, a random seed), off or a seed." << std::endl;
+	std::cout << "\t\t[--ids MODE]          -- read vertex names as integers or strings: auto (default, integers if all are), numeric or names." << std::endl;
 } // end method display_help
 
 
 int main(int argc, char** argv)
 {
+	string str_option;
+
+	const std::size_t n_labelg_procs = extract_option(argc, argv, "--labelg-processes", str_option) ? std::stoul(str_option) : 0;
+	const std::size_t n_labelg_workers = extract_option(argc, argv, "--labelg-workers", str_option) ? std::stoul(str_option) : 0;
+	const string label_cache_path = extract_option(argc, argv, "--label-cache", str_option) ? str_option : "";
+	const bool directed = extract_flag(argc, argv, {"-d", "--directed"});
+	const VertexOrder vertex_order = parse_vertex_order(extract_option(argc, argv, "--order", str_option) ? str_option : "none");
+	const DenseAdjacency dense_adjacency = parse_dense_adjacency(extract_option(argc, argv, "--dense-adjacency", str_option) ? str_option : "auto");
+	const CSROptions csr_options{vertex_order, dense_adjacency};
+
+	ParseOptions parse_options;
+
+	if (true == extract_option(argc, argv, "--shuffle", str_option))
+	{
+		parse_shuffle(str_option, parse_options);
+	} // end if
+
+	if (true == extract_option(argc, argv, "--ids", str_option))
+	{
+		parse_options.m_ids = parse_vertex_ids(str_option);
+	} // end if
+
     if(argc > 6 || (argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help")))
 	{
 		display_help(argv[0]);
@@ -49,11 +83,34 @@ int main(int argc, char** argv)
     // -v option can be used to change verbosity
     loguru::init(argc, argv);
 
+	// a warm cache spares most calls to the labeler
+	std::size_t n_cache_skipped = 0;
+
+	if (false == label_cache_path.empty() && true == LabelCache::instance().load(label_cache_path, &n_cache_skipped))
+	{
+		LOG_F(INFO, "Loaded %zu cannonical labels from %s", LabelCache::instance().size(), label_cache_path.c_str());
+
+		if (n_cache_skipped > 0)
+		{
+			LOG_F(WARNING, "Skipped %zu labels of %s whose size or directedness is wrong, they will be relabeled", n_cache_skipped, label_cache_path.c_str());
+		} // end if
+	} // end if
+
 	const string filename = argc > 1 ? argv[1] : "./test/exampleGraph.txt";
 	const std::size_t n_threads = argc > 2 ? atoi(argv[2]) : 16;
 	const std::size_t motifSize = argc > 3 ? atoi(argv[3]) : 4;
 	const std::size_t randomCount = argc > 4 ? atoi(argv[4]) : 1000;
-	const string labelg_path = argc > 5 ? argv[5] : "./labelg";
+	const string labelg_path = argc > 5 ? argv[5] : (_USE_NAUTY ? "" : "./labelg");
+	const LabelGOptions labelg_options{labelg_path, n_labelg_procs, n_labelg_workers};
+
+	if (false == check_motif_size(motifSize, directed))
+	{
+		display_help(argv[0]);
+		return 1;
+	} // end if
+
+	// the edge list is parsed on as many threads as the enumeration
+	parse_options.mu_li_threads = n_threads;
 
 	SubgraphCount subc;
 	vector<double> probs(motifSize - 2, 1.0);
@@ -67,22 +124,28 @@ int main(int argc, char** argv)
 
 	auto begin = _Clock::now();
 
-	Graph targetg(filename, false);
+	const CSRGraph targetg = read_graph(filename, directed, parse_options, csr_options);
+
+	// digraph6 files and snapshots are directed without -d
+	if (false == check_motif_size(motifSize, targetg.isDirected()))
+	{
+		return 1;
+	} // end if
 
     LOG_F(INFO, "Enumerating graph ...");
 
-	ESU_Parallel::enumerate<SubgraphCount>(targetg, &subc, static_cast<int>(motifSize), &my_pool, labelg_path);
+	ESU_Parallel::enumerate<SubgraphCount>(targetg, &subc, static_cast<int>(motifSize), &my_pool, labelg_options);
 
     LOG_F(INFO, "Done Enumerating. Getting relative frequencies ...");
 
-	unordered_map<std::string, double> targetLabelRelFreqMap(std::move(subc.getRelativeFrequencies()));
+	unordered_map<MotifCode, double> targetLabelRelFreqMap(std::move(subc.getRelativeFrequencies()));
 
     LOG_F(INFO, "Analyzing random graphs...\n");
 
 
 	Parallel_Analysis::AnalyzeArgPack analyze_args
 	(
-		&targetg, randomCount, motifSize, probs, &my_pool, labelg_path
+		&targetg, randomCount, motifSize, probs, &my_pool, labelg_options, csr_options
 	);
 
 	auto randLabelRelFreqsMap = std::move(Parallel_Analysis::analyze(analyze_args));
@@ -90,6 +153,11 @@ int main(int argc, char** argv)
 	// alert all threads to terminate
 	my_pool.Kill_All();
 
+	if (false == label_cache_path.empty())
+	{
+		LabelCache::instance().save(label_cache_path);
+	} // end if
+
     LOG_F(INFO, "Comparing target graph to random graphs ...\n");
 
 	Statistical_Analysis::stats_data data{&targetLabelRelFreqMap, &randLabelRelFreqsMap, randomCount};
@@ -0,0 +1,901 @@
+#include <algorithm> // sort, copy, transform, stable_sort, max, reverse
+#include <numeric>   // iota, partial_sum
+#include <stdexcept> // invalid_argument
+#include <cmath>     // log2
+#include <queue>     // queue
+#include <cstdio>    // FILE, fopen, fwrite, fclose, rename, remove
+#include <cerrno>    // errno
+#include <cstring>   // memcpy, strerror
+
+#include <fcntl.h>     // open, O_RDONLY
+#include <unistd.h>    // close, getpid
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+
+#include "CSRGraph.hpp"
+
+#include "loguru.hpp"  // LOG_F
+
+
+namespace
+{
+    //! first word of a snapshot file
+    constexpr std::uint64_t ku_CSR_MAGIC = 0x005253434F4D454Eull; // "NEMOCSR"
+    //! bumped whenever the layout of the file changes
+    constexpr std::uint32_t ku_CSR_VERSION = 1;
+
+    //! header flags
+    constexpr std::uint32_t ku_CSR_DIRECTED = 1;
+    constexpr std::uint32_t ku_CSR_RENUMBERED = 2;
+    constexpr std::uint32_t ku_CSR_NAMED = 4;
+
+    /** @brief The fixed size start of a snapshot file.*/
+    struct CSRFileHeader
+    {
+        std::uint64_t u_magic;
+        std::uint32_t u_version;
+        std::uint32_t u_flags;
+        //! number of vertices
+        std::uint64_t u_vertices;
+        //! length of the neighbor array, twice the number of edges
+        std::uint64_t u_neighbors;
+        //! total length of the vertex names
+        std::uint64_t u_name_bytes;
+    }; // end struct CSRFileHeader
+
+    // the offsets are written and mapped as they are
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "snapshot files need 64-bit offsets");
+
+
+    /** @brief Rounds a section length up to the 8 byte alignment of the next.*/
+    constexpr std::size_t aligned(const std::size_t ku_li_BYTES_) noexcept
+    {
+        return (ku_li_BYTES_ + 7) & ~std::size_t{7};
+    } // end method aligned
+
+
+    /** @brief Byte lengths of the sections of a snapshot file, in file order.*/
+    std::vector<std::size_t> section_sizes(const CSRFileHeader& kr_HEADER_)
+    {
+        const std::size_t ku_li_n = kr_HEADER_.u_vertices;
+        const std::size_t ku_li_m = kr_HEADER_.u_neighbors;
+        const bool kb_renumbered = 0 != (kr_HEADER_.u_flags & ku_CSR_RENUMBERED);
+        const bool kb_named = 0 != (kr_HEADER_.u_flags & ku_CSR_NAMED);
+
+        return {
+            aligned((ku_li_n + 1) * sizeof(std::uint64_t)),
+            aligned(ku_li_m * sizeof(vertex)),
+            aligned(0 != (kr_HEADER_.u_flags & ku_CSR_DIRECTED) ? ku_li_m : 0),
+            aligned(kb_renumbered ? ku_li_n * sizeof(vertex) : 0),
+            aligned(kb_renumbered ? ku_li_n * sizeof(vertex) : 0),
+            aligned(kb_named ? (ku_li_n + 1) * sizeof(std::uint64_t) : 0),
+            aligned(kb_named ? kr_HEADER_.u_name_bytes : 0)
+        };
+    } // end method section_sizes
+
+
+    /** @brief Sorts in parallel where the standard library can.*/
+    template <typename It, typename Compare>
+    void parallel_sort(It begin_, It end_, Compare compare_)
+    {
+        #if _C17_EXECUTION_AVAILABLE
+            std::sort(std::execution::par_unseq, begin_, end_, compare_);
+        #else
+            std::sort(begin_, end_, compare_);
+        #endif
+    } // end method parallel_sort
+
+
+    /** @brief Vertices by ascending degree, ties by number.
+      * @remark The orders take a Graph or a CSRGraph.
+      */
+    template <typename G>
+    std::vector<vertex> degree_order(const G& kr_GRAPH_)
+    {
+        std::vector<vertex> vect_order(kr_GRAPH_.getSize());
+        std::iota(vect_order.begin(), vect_order.end(), 0);
+
+        std::stable_sort(vect_order.begin(), vect_order.end(),
+            [&](const vertex a, const vertex b)
+            {
+                return kr_GRAPH_.getAdjacencyList(a).size() < kr_GRAPH_.getAdjacencyList(b).size();
+            } // end lambda
+        );
+
+        return vect_order;
+    } // end method degree_order
+
+
+    /** @brief Vertices in the order a k-core decomposition removes them,
+      *        repeatedly taking a vertex of smallest remaining degree.
+      * @remark Bucket queue of Matula and Beck, linear in the graph size.
+      */
+    template <typename G>
+    std::vector<vertex> degeneracy_order(const G& kr_GRAPH_)
+    {
+        const std::size_t ku_li_n = kr_GRAPH_.getSize();
+
+        //! remaining degree of every vertex
+        std::vector<std::size_t> vect_degree(ku_li_n);
+        std::size_t u_li_max_degree{0};
+
+        for (std::size_t v{0}; v < ku_li_n; v++)
+        {
+            vect_degree[v] = kr_GRAPH_.getAdjacencyList(static_cast<vertex>(v)).size();
+            u_li_max_degree = std::max(u_li_max_degree, vect_degree[v]);
+        } // end for v
+
+        // vertices sorted by remaining degree, with the start of
+        // every degree's bucket and every vertex's position
+        std::vector<std::size_t> vect_bucket_start(u_li_max_degree + 2, 0);
+        std::vector<vertex> vect_sorted(ku_li_n);
+        std::vector<std::size_t> vect_position(ku_li_n);
+
+        for (std::size_t v{0}; v < ku_li_n; v++)
+        {
+            vect_bucket_start[vect_degree[v] + 1]++;
+        } // end for v
+
+        std::partial_sum(vect_bucket_start.begin(), vect_bucket_start.end(), vect_bucket_start.begin());
+
+        std::vector<std::size_t> vect_next(vect_bucket_start.begin(), vect_bucket_start.end() - 1);
+
+        for (std::size_t v{0}; v < ku_li_n; v++)
+        {
+            vect_position[v] = vect_next[vect_degree[v]]++;
+            vect_sorted[vect_position[v]] = static_cast<vertex>(v);
+        } // end for v
+
+        for (std::size_t i{0}; i < ku_li_n; i++)
+        {
+            // the smallest remaining degree is always at position i
+            const vertex v = vect_sorted[i];
+
+            for (const vertex u : kr_GRAPH_.getAdjacencyList(v))
+            {
+                if (vect_position[u] <= i || vect_degree[u] <= vect_degree[v])
+                {
+                    continue;
+                } // end if
+
+                // move u to the front of its bucket and shrink the bucket
+                const std::size_t ku_li_front = std::max(vect_bucket_start[vect_degree[u]], i + 1);
+                const vertex w = vect_sorted[ku_li_front];
+
+                std::swap(vect_sorted[vect_position[u]], vect_sorted[ku_li_front]);
+                std::swap(vect_position[u], vect_position[w]);
+
+                vect_bucket_start[vect_degree[u]] = ku_li_front + 1;
+                vect_degree[u]--;
+            } // end for u
+        } // end for i
+
+        return vect_sorted;
+    } // end method degeneracy_order
+
+
+    /** @brief Vertices in reverse Cuthill-McKee order.
+      * @remark Every component is traversed breadth first from one of its
+      *         vertices of smallest degree, visiting the neighbors of each
+      *         vertex by ascending degree.
+      */
+    template <typename G>
+    std::vector<vertex> rcm_order(const G& kr_GRAPH_)
+    {
+        const std::size_t ku_li_n = kr_GRAPH_.getSize();
+
+        auto degree_of = [&](const vertex v)
+        {
+            return kr_GRAPH_.getAdjacencyList(v).size();
+        }; // end lambda
+
+        // components are started from their lowest degree vertex
+        // by trying the candidates by ascending degree
+        std::vector<vertex> vect_starts = degree_order(kr_GRAPH_);
+        std::vector<vertex> vect_order;
+        std::vector<bool> vect_visited(ku_li_n, false);
+        std::vector<vertex> vect_neighbors;
+
+        vect_order.reserve(ku_li_n);
+
+        for (const vertex s : vect_starts)
+        {
+            if (true == vect_visited[s])
+            {
+                continue;
+            } // end if
+
+            // the order doubles as the bfs queue
+            std::size_t u_li_head = vect_order.size();
+
+            vect_visited[s] = true;
+            vect_order.push_back(s);
+
+            while (u_li_head < vect_order.size())
+            {
+                const vertex v = vect_order[u_li_head++];
+                const auto& kr_adjacency = kr_GRAPH_.getAdjacencyList(v);
+
+                vect_neighbors.clear();
+
+                for (const vertex u : kr_adjacency)
+                {
+                    if (false == vect_visited[u])
+                    {
+                        vect_visited[u] = true;
+                        vect_neighbors.push_back(u);
+                    } // end if
+                } // end for u
+
+                std::sort(vect_neighbors.begin(), vect_neighbors.end(),
+                    [&](const vertex a, const vertex b)
+                    {
+                        return degree_of(a) < degree_of(b) || (degree_of(a) == degree_of(b) && a < b);
+                    } // end lambda
+                );
+
+                vect_order.insert(vect_order.end(), vect_neighbors.begin(), vect_neighbors.end());
+            } // end while
+        } // end for s
+
+        std::reverse(vect_order.begin(), vect_order.end());
+
+        return vect_order;
+    } // end method rcm_order
+} // end namespace
+
+
+VertexOrder parse_vertex_order(const std::string& kr_str_NAME_)
+{
+    if ("none" == kr_str_NAME_)
+    {
+        return VertexOrder::NONE;
+    } // end if
+    else if ("degree" == kr_str_NAME_)
+    {
+        return VertexOrder::DEGREE;
+    } // end elif
+    else if ("degeneracy" == kr_str_NAME_)
+    {
+        return VertexOrder::DEGENERACY;
+    } // end elif
+    else if ("rcm" == kr_str_NAME_)
+    {
+        return VertexOrder::RCM;
+    } // end elif
+
+    throw std::invalid_argument("Unknown vertex order '" + kr_str_NAME_ + "', expected none, degree, degeneracy or rcm");
+} // end method parse_vertex_order
+
+
+DenseAdjacency parse_dense_adjacency(const std::string& kr_str_NAME_)
+{
+    if ("auto" == kr_str_NAME_)
+    {
+        return DenseAdjacency::AUTO;
+    } // end if
+    else if ("on" == kr_str_NAME_)
+    {
+        return DenseAdjacency::ON;
+    } // end elif
+    else if ("off" == kr_str_NAME_)
+    {
+        return DenseAdjacency::OFF;
+    } // end elif
+
+    throw std::invalid_argument("Unknown dense adjacency mode '" + kr_str_NAME_ + "', expected auto, on or off");
+} // end method parse_dense_adjacency
+
+
+CSRGraph::CSRGraph(const Graph& kr_GRAPH_, const CSROptions& kr_OPTIONS_)
+ : mu_li_n(kr_GRAPH_.getSize()), m_b_directed(kr_GRAPH_.isDirected())
+{
+    const std::size_t ku_li_n = mu_li_n;
+
+    switch (kr_OPTIONS_.m_order)
+    {
+        case VertexOrder::DEGREE:     m_vect_original = degree_order(kr_GRAPH_); break;
+        case VertexOrder::DEGENERACY: m_vect_original = degeneracy_order(kr_GRAPH_); break;
+        case VertexOrder::RCM:        m_vect_original = rcm_order(kr_GRAPH_); break;
+        case VertexOrder::NONE:       break;
+    } // end switch
+
+    m_vect_renumbered.resize(m_vect_original.empty() ? 0 : ku_li_n);
+
+    for (std::size_t v{0}; v < m_vect_renumbered.size(); v++)
+    {
+        m_vect_renumbered[m_vect_original[v]] = static_cast<vertex>(v);
+    } // end for v
+
+    m_vect_offsets.reserve(ku_li_n + 1);
+    m_vect_offsets.push_back(0);
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        const vertex k_g = m_vect_original.empty() ? static_cast<vertex>(v) : m_vect_original[v];
+
+        m_vect_offsets.push_back(m_vect_offsets.back() + kr_GRAPH_.getAdjacencyList(k_g).size());
+    } // end for v
+
+    m_vect_neighbors.resize(m_vect_offsets.back());
+
+    if (true == m_b_directed)
+    {
+        m_vect_types.assign(m_vect_neighbors.size(), NOEDGE_UV);
+    } // end if
+
+    // nothing is resized past here
+    bindOwned();
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        const auto& kr_adjacency = kr_GRAPH_.getAdjacencyList(original(static_cast<vertex>(v)));
+        const auto k_it_begin = m_vect_neighbors.begin() + static_cast<std::ptrdiff_t>(m_vect_offsets[v]);
+
+        if (true == m_vect_renumbered.empty())
+        {
+            std::copy(kr_adjacency.begin(), kr_adjacency.end(), k_it_begin);
+        } // end if
+        else
+        {
+            std::transform(kr_adjacency.begin(), kr_adjacency.end(), k_it_begin,
+                [&](const vertex u)
+                {
+                    return m_vect_renumbered[u];
+                } // end lambda
+            );
+        } // end else
+
+        std::sort(k_it_begin, k_it_begin + static_cast<std::ptrdiff_t>(kr_adjacency.size()));
+    } // end for v
+
+    if (true == m_b_directed)
+    {
+        // the slot of a neighbor in the sorted row of a vertex
+        auto slot_of = [this](const vertex v, const vertex u)
+        {
+            const NeighborRange k_neighbors = getAdjacencyList(v);
+
+            return static_cast<std::size_t>(std::lower_bound(k_neighbors.begin(), k_neighbors.end(), u) - mp_neighbors);
+        }; // end lambda
+
+        for (std::size_t v{0}; v < ku_li_n; v++)
+        {
+            const vertex k_v = static_cast<vertex>(v);
+
+            for (const vertex u : kr_GRAPH_.getOutAdjacencyList(original(k_v)))
+            {
+                m_vect_types[slot_of(k_v, renumbered(u))] |= DIR_U_T_V;
+            } // end for u
+
+            for (const vertex u : kr_GRAPH_.getInAdjacencyList(original(k_v)))
+            {
+                m_vect_types[slot_of(k_v, renumbered(u))] |= DIR_V_T_U;
+            } // end for u
+        } // end for v
+    } // end if
+
+    buildEdgeTests(kr_OPTIONS_.m_dense);
+} // end Constructor
+
+
+CSRGraph::CSRGraph(const EdgeList& kr_EDGES_, const CSROptions& kr_OPTIONS_)
+ : mu_li_n(kr_EDGES_.mu_li_vertices), m_b_directed(kr_EDGES_.m_b_directed)
+{
+    const std::size_t ku_li_entries = 2 * kr_EDGES_.m_vect_edges.size();
+
+    //! every edge in the rows of both its ends, keyed (row, column) so
+    //! that sorting the keys lays the rows out one after another
+    std::vector<std::uint64_t> vect_keys(ku_li_entries);
+    //! direction of every key, relative to its row, directed only
+    std::vector<std::uint8_t> vect_key_types(true == m_b_directed ? ku_li_entries : 0);
+
+    for (std::size_t e{0}; e < kr_EDGES_.m_vect_edges.size(); e++)
+    {
+        const std::uint64_t ku_u = kr_EDGES_.m_vect_edges[e].first;
+        const std::uint64_t ku_v = kr_EDGES_.m_vect_edges[e].second;
+
+        vect_keys[2 * e] = (ku_u << 32) | ku_v;
+        vect_keys[2 * e + 1] = (ku_v << 32) | ku_u;
+    } // end for e
+
+    if (true == m_b_directed)
+    {
+        // the types follow the keys through the sort, so the
+        // sort permutes an index into both
+        std::vector<std::uint64_t> vect_index(ku_li_entries);
+        std::iota(vect_index.begin(), vect_index.end(), 0);
+
+        parallel_sort(vect_index.begin(), vect_index.end(),
+            [&](const std::uint64_t a, const std::uint64_t b)
+            {
+                return vect_keys[a] < vect_keys[b];
+            } // end lambda
+        );
+
+        std::vector<std::uint64_t> vect_sorted(ku_li_entries);
+
+        for (std::size_t i{0}; i < ku_li_entries; i++)
+        {
+            vect_sorted[i] = vect_keys[vect_index[i]];
+            vect_key_types[i] = (0 == vect_index[i] % 2) ? DIR_U_T_V : DIR_V_T_U;
+        } // end for i
+
+        vect_keys = std::move(vect_sorted);
+    } // end if
+    else
+    {
+        parallel_sort(vect_keys.begin(), vect_keys.end(), std::less<std::uint64_t>());
+    } // end else
+
+    // repeated edges collapse into one neighbor with all their directions
+    std::size_t u_li_unique{0};
+
+    for (std::size_t i{0}; i < ku_li_entries; i++)
+    {
+        if (u_li_unique > 0 && vect_keys[u_li_unique - 1] == vect_keys[i])
+        {
+            if (true == m_b_directed)
+            {
+                vect_key_types[u_li_unique - 1] |= vect_key_types[i];
+            } // end if
+
+            continue;
+        } // end if
+
+        vect_keys[u_li_unique] = vect_keys[i];
+
+        if (true == m_b_directed)
+        {
+            vect_key_types[u_li_unique] = vect_key_types[i];
+        } // end if
+
+        u_li_unique++;
+    } // end for i
+
+    m_vect_offsets.assign(mu_li_n + 1, 0);
+    m_vect_neighbors.resize(u_li_unique);
+
+    for (std::size_t i{0}; i < u_li_unique; i++)
+    {
+        m_vect_offsets[(vect_keys[i] >> 32) + 1]++;
+        m_vect_neighbors[i] = static_cast<vertex>(vect_keys[i] & 0xFFFFFFFFull);
+    } // end for i
+
+    std::partial_sum(m_vect_offsets.begin(), m_vect_offsets.end(), m_vect_offsets.begin());
+
+    if (true == m_b_directed)
+    {
+        vect_key_types.resize(u_li_unique);
+        m_vect_types = std::move(vect_key_types);
+    } // end if
+
+    bindOwned();
+
+    switch (kr_OPTIONS_.m_order)
+    {
+        case VertexOrder::DEGREE:     renumber(degree_order(*this)); break;
+        case VertexOrder::DEGENERACY: renumber(degeneracy_order(*this)); break;
+        case VertexOrder::RCM:        renumber(rcm_order(*this)); break;
+        case VertexOrder::NONE:       break;
+    } // end switch
+
+    buildEdgeTests(kr_OPTIONS_.m_dense);
+} // end Constructor
+
+
+void CSRGraph::renumber(std::vector<vertex> vect_original_)
+{
+    const std::size_t ku_li_n = getSize();
+
+    m_vect_original = std::move(vect_original_);
+    m_vect_renumbered.resize(ku_li_n);
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        m_vect_renumbered[m_vect_original[v]] = static_cast<vertex>(v);
+    } // end for v
+
+    std::vector<std::size_t> vect_offsets(ku_li_n + 1, 0);
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        vect_offsets[v + 1] = vect_offsets[v] + degree(m_vect_original[v]);
+    } // end for v
+
+    std::vector<vertex> vect_neighbors(m_vect_neighbors.size());
+    std::vector<std::uint8_t> vect_types(m_vect_types.size());
+    std::vector<std::pair<vertex, std::uint8_t>> vect_row;
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        const vertex k_old = m_vect_original[v];
+
+        vect_row.clear();
+
+        for (std::size_t i{m_vect_offsets[k_old]}; i < m_vect_offsets[k_old + 1]; i++)
+        {
+            vect_row.emplace_back(m_vect_renumbered[m_vect_neighbors[i]], m_b_directed ? m_vect_types[i] : NOEDGE_UV);
+        } // end for i
+
+        std::sort(vect_row.begin(), vect_row.end());
+
+        for (std::size_t i{0}; i < vect_row.size(); i++)
+        {
+            vect_neighbors[vect_offsets[v] + i] = vect_row[i].first;
+
+            if (true == m_b_directed)
+            {
+                vect_types[vect_offsets[v] + i] = vect_row[i].second;
+            } // end if
+        } // end for i
+    } // end for v
+
+    m_vect_offsets = std::move(vect_offsets);
+    m_vect_neighbors = std::move(vect_neighbors);
+    m_vect_types = std::move(vect_types);
+
+    bindOwned();
+} // end method renumber
+
+
+void CSRGraph::bindOwned(void) noexcept
+{
+    mp_offsets = m_vect_offsets.data();
+    mp_neighbors = m_vect_neighbors.data();
+    mp_types = m_vect_types.empty() ? nullptr : m_vect_types.data();
+    mp_original = m_vect_original.empty() ? nullptr : m_vect_original.data();
+    mp_renumbered = m_vect_renumbered.empty() ? nullptr : m_vect_renumbered.data();
+} // end method bindOwned
+
+
+void CSRGraph::buildEdgeTests(const DenseAdjacency k_DENSE_)
+{
+    const std::size_t ku_li_n = getSize();
+    const bool kb_dense = DenseAdjacency::ON == k_DENSE_
+                       || (DenseAdjacency::AUTO == k_DENSE_ && ku_li_n <= _DENSE_ADJACENCY_MAX_VERTICES);
+
+    if (true == kb_dense && ku_li_n > 0)
+    {
+        mu_li_row_words = (ku_li_n + 63) / 64;
+        m_vect_matrix.assign(ku_li_n * mu_li_row_words, 0);
+
+        for (std::size_t v{0}; v < ku_li_n; v++)
+        {
+            std::uint64_t* p_row = m_vect_matrix.data() + v * mu_li_row_words;
+
+            for (const vertex u : getAdjacencyList(static_cast<vertex>(v)))
+            {
+                p_row[u / 64] |= std::uint64_t{1} << (u % 64);
+            } // end for u
+        } // end for v
+    } // end if
+    else
+    {
+        buildHubBitsets();
+    } // end else
+} // end method buildEdgeTests
+
+
+void CSRGraph::buildHubBitsets(void)
+{
+    const std::size_t ku_li_n = getSize();
+
+    // a bitset of n bits may cost at most eight times the sorted array it
+    // shadows, which bounds the bitsets by eight times the neighbor array
+    const std::size_t ku_li_min_degree = std::max<std::size_t>(_HUB_MIN_DEGREE, ku_li_n / 256);
+
+    std::vector<vertex> vect_hubs;
+
+    for (std::size_t v{0}; v < ku_li_n; v++)
+    {
+        if (degree(static_cast<vertex>(v)) >= ku_li_min_degree)
+        {
+            vect_hubs.push_back(static_cast<vertex>(v));
+        } // end if
+    } // end for v
+
+    if (true == vect_hubs.empty())
+    {
+        return;
+    } // end if
+
+    mu_li_row_words = (ku_li_n + 63) / 64;
+    m_vect_hub_rows.assign(ku_li_n, ku_NOT_A_HUB);
+    m_vect_hub_bits.assign(vect_hubs.size() * mu_li_row_words, 0);
+
+    for (std::size_t h{0}; h < vect_hubs.size(); h++)
+    {
+        std::uint64_t* p_row = m_vect_hub_bits.data() + h * mu_li_row_words;
+
+        m_vect_hub_rows[vect_hubs[h]] = static_cast<std::uint32_t>(h);
+
+        for (const vertex u : getAdjacencyList(vect_hubs[h]))
+        {
+            p_row[u / 64] |= std::uint64_t{1} << (u % 64);
+        } // end for u
+    } // end for h
+} // end method buildHubBitsets
+
+
+CSRGraph::Locality CSRGraph::locality(void) const
+{
+    Locality locality{0.0, 0};
+
+    for (std::size_t v{0}; v < getSize(); v++)
+    {
+        // every edge is counted from its smaller end
+        for (const vertex u : getAdjacencyList(static_cast<vertex>(v)).above(static_cast<vertex>(v)))
+        {
+            const std::size_t ku_li_gap = u - v;
+
+            locality.md_mean_log_gap += std::log2(static_cast<double>(ku_li_gap + 1));
+            locality.mu_li_bandwidth = std::max(locality.mu_li_bandwidth, ku_li_gap);
+        } // end for u
+    } // end for v
+
+    if (getEdgeCount() > 0)
+    {
+        locality.md_mean_log_gap /= static_cast<double>(getEdgeCount());
+    } // end if
+
+    return locality;
+} // end method locality
+
+
+CSRGraph::Locality CSRGraph::locality(const EdgeList& kr_EDGES_)
+{
+    Locality locality{0.0, 0};
+
+    for (const auto& kr_edge : kr_EDGES_.m_vect_edges)
+    {
+        const std::size_t ku_li_gap = kr_edge.first < kr_edge.second ? kr_edge.second - kr_edge.first : kr_edge.first - kr_edge.second;
+
+        locality.md_mean_log_gap += std::log2(static_cast<double>(ku_li_gap + 1));
+        locality.mu_li_bandwidth = std::max(locality.mu_li_bandwidth, ku_li_gap);
+    } // end for kr_edge
+
+    if (false == kr_EDGES_.m_vect_edges.empty())
+    {
+        locality.md_mean_log_gap /= static_cast<double>(kr_EDGES_.m_vect_edges.size());
+    } // end if
+
+    return locality;
+} // end method locality
+
+
+bool CSRGraph::is_mapped_format(const std::string& kr_str_PATH_)
+{
+    FILE* p_file = std::fopen(kr_str_PATH_.c_str(), "rb");
+
+    if (nullptr == p_file)
+    {
+        return false;
+    } // end if
+
+    std::uint64_t u_magic{0};
+    const bool kb_read = (1 == std::fread(&u_magic, sizeof(u_magic), 1, p_file));
+
+    std::fclose(p_file);
+
+    return true == kb_read && ku_CSR_MAGIC == u_magic;
+} // end method is_mapped_format
+
+
+void CSRGraph::save(const std::string& kr_str_PATH_, const std::vector<std::string>& kr_vect_NAMES_) const
+{
+    // names are stored in the numbering of the Graph
+    std::vector<std::uint64_t> vect_name_offsets;
+    std::string str_names;
+
+    if (false == kr_vect_NAMES_.empty())
+    {
+        if (kr_vect_NAMES_.size() != mu_li_n)
+        {
+            throw std::invalid_argument("A snapshot of " + std::to_string(mu_li_n) + " vertices can't be saved with " + std::to_string(kr_vect_NAMES_.size()) + " names");
+        } // end if
+
+        vect_name_offsets.reserve(mu_li_n + 1);
+        vect_name_offsets.push_back(0);
+
+        for (const std::string& kr_str_name : kr_vect_NAMES_)
+        {
+            str_names += kr_str_name;
+            vect_name_offsets.push_back(str_names.size());
+        } // end for kr_str_name
+    } // end if
+
+    CSRFileHeader header{};
+
+    header.u_magic = ku_CSR_MAGIC;
+    header.u_version = ku_CSR_VERSION;
+    header.u_flags = (m_b_directed ? ku_CSR_DIRECTED : 0)
+                   | (isRelabeled() ? ku_CSR_RENUMBERED : 0)
+                   | (vect_name_offsets.empty() ? 0 : ku_CSR_NAMED);
+    header.u_vertices = mu_li_n;
+    header.u_neighbors = mp_offsets[mu_li_n];
+    header.u_name_bytes = str_names.size();
+
+    const std::vector<std::size_t> k_vect_sizes = section_sizes(header);
+    const void* k_arr_sections[] = {
+        mp_offsets, mp_neighbors, mp_types, mp_original, mp_renumbered, vect_name_offsets.data(), str_names.data()
+    };
+    const std::size_t k_arr_lengths[] = {
+        (mu_li_n + 1) * sizeof(std::uint64_t),
+        header.u_neighbors * sizeof(vertex),
+        m_b_directed ? header.u_neighbors : 0,
+        isRelabeled() ? mu_li_n * sizeof(vertex) : 0,
+        isRelabeled() ? mu_li_n * sizeof(vertex) : 0,
+        vect_name_offsets.size() * sizeof(std::uint64_t),
+        str_names.size()
+    };
+
+    const std::string kr_str_tmp_path = kr_str_PATH_ + "." + std::to_string(getpid()) + ".tmp";
+
+    FILE* p_file = std::fopen(kr_str_tmp_path.c_str(), "wb");
+
+    if (nullptr == p_file)
+    {
+        throw std::runtime_error("Can't write graph snapshot '" + kr_str_tmp_path + "': " + std::strerror(errno));
+    } // end if
+
+    const char k_arr_padding[8] = {0};
+    bool b_ok = (1 == std::fwrite(&header, sizeof(header), 1, p_file));
+
+    for (std::size_t s{0}; s < k_vect_sizes.size(); s++)
+    {
+        if (0 == k_arr_lengths[s])
+        {
+            continue;
+        } // end if
+
+        b_ok = b_ok && (1 == std::fwrite(k_arr_sections[s], k_arr_lengths[s], 1, p_file));
+        b_ok = b_ok && (k_vect_sizes[s] - k_arr_lengths[s] == std::fwrite(k_arr_padding, 1, k_vect_sizes[s] - k_arr_lengths[s], p_file));
+    } // end for s
+
+    b_ok = (0 == std::fclose(p_file)) && b_ok;
+
+    if (false == b_ok || 0 != std::rename(kr_str_tmp_path.c_str(), kr_str_PATH_.c_str()))
+    {
+        std::remove(kr_str_tmp_path.c_str());
+        throw std::runtime_error("Can't write graph snapshot '" + kr_str_PATH_ + "'");
+    } // end if
+} // end method save
+
+
+CSRGraph CSRGraph::open_mapped(const std::string& kr_str_PATH_, const DenseAdjacency k_DENSE_)
+{
+    const int k_fd = open(kr_str_PATH_.c_str(), O_RDONLY);
+
+    if (-1 == k_fd)
+    {
+        throw std::runtime_error("Can't open graph snapshot '" + kr_str_PATH_ + "': " + std::strerror(errno));
+    } // end if
+
+    struct stat file_stat;
+
+    if (-1 == fstat(k_fd, &file_stat))
+    {
+        close(k_fd);
+        throw std::runtime_error("Can't stat graph snapshot '" + kr_str_PATH_ + "'");
+    } // end if
+
+    const std::size_t ku_li_size = static_cast<std::size_t>(file_stat.st_size);
+
+    if (ku_li_size < sizeof(CSRFileHeader))
+    {
+        close(k_fd);
+        throw std::runtime_error("'" + kr_str_PATH_ + "' is not a graph snapshot");
+    } // end if
+
+    // shared and read-only, so every process mapping the file
+    // reads the same pages of the page cache
+    void* p_map = mmap(nullptr, ku_li_size, PROT_READ, MAP_SHARED, k_fd, 0);
+
+    // the mapping stays valid once the descriptor is closed
+    close(k_fd);
+
+    if (MAP_FAILED == p_map)
+    {
+        throw std::runtime_error("Can't map graph snapshot '" + kr_str_PATH_ + "'");
+    } // end if
+
+    CSRGraph graph;
+
+    graph.m_p_mapping = std::shared_ptr<const void>(p_map,
+        [ku_li_size](const void* p_)
+        {
+            munmap(const_cast<void*>(p_), ku_li_size);
+        } // end lambda
+    );
+
+    const unsigned char* p_bytes = static_cast<const unsigned char*>(p_map);
+    CSRFileHeader header;
+
+    std::memcpy(&header, p_bytes, sizeof(header));
+
+    if (ku_CSR_MAGIC != header.u_magic)
+    {
+        throw std::runtime_error("'" + kr_str_PATH_ + "' is not a graph snapshot");
+    } // end if
+
+    if (ku_CSR_VERSION != header.u_version)
+    {
+        throw std::runtime_error("Graph snapshot '" + kr_str_PATH_ + "' has format version " + std::to_string(header.u_version) 
+                               + ", expected " + std::to_string(ku_CSR_VERSION));
+    } // end if
+
+    const std::vector<std::size_t> k_vect_sizes = section_sizes(header);
+    std::vector<const unsigned char*> vect_sections;
+    std::size_t u_li_position = sizeof(CSRFileHeader);
+
+    for (const std::size_t ku_li_section : k_vect_sizes)
+    {
+        vect_sections.push_back(p_bytes + u_li_position);
+        u_li_position += ku_li_section;
+    } // end for ku_li_section
+
+    if (u_li_position > ku_li_size)
+    {
+        throw std::runtime_error("Graph snapshot '" + kr_str_PATH_ + "' is truncated");
+    } // end if
+
+    graph.mu_li_n = header.u_vertices;
+    graph.m_b_directed = 0 != (header.u_flags & ku_CSR_DIRECTED);
+    graph.mp_offsets = reinterpret_cast<const std::size_t*>(vect_sections[0]);
+    graph.mp_neighbors = reinterpret_cast<const vertex*>(vect_sections[1]);
+
+    if (header.u_neighbors != graph.mp_offsets[graph.mu_li_n])
+    {
+        throw std::runtime_error("Graph snapshot '" + kr_str_PATH_ + "' is corrupt");
+    } // end if
+
+    if (true == graph.m_b_directed)
+    {
+        graph.mp_types = vect_sections[2];
+    } // end if
+
+    if (0 != (header.u_flags & ku_CSR_RENUMBERED))
+    {
+        graph.mp_original = reinterpret_cast<const vertex*>(vect_sections[3]);
+        graph.mp_renumbered = reinterpret_cast<const vertex*>(vect_sections[4]);
+    } // end if
+
+    if (0 != (header.u_flags & ku_CSR_NAMED))
+    {
+        graph.mp_name_offsets = reinterpret_cast<const std::uint64_t*>(vect_sections[5]);
+        graph.mp_names = reinterpret_cast<const char*>(vect_sections[6]);
+    } // end if
+
+    graph.buildEdgeTests(k_DENSE_);
+
+    return graph;
+} // end method open_mapped
+
+
+CSRGraph read_graph(const std::string& kr_str_PATH_, const bool kb_DIRECTED_, const ParseOptions& kr_PARSE_OPTIONS_, const CSROptions& kr_CSR_OPTIONS_)
+{
+    if (true == CSRGraph::is_mapped_format(kr_str_PATH_))
+    {
+        LOG_F(INFO, "Mapping graph snapshot %s, its own direction and vertex order are kept", kr_str_PATH_.c_str());
+
+        return CSRGraph::open_mapped(kr_str_PATH_, kr_CSR_OPTIONS_.m_dense);
+    } // end if
+
+    const EdgeList edges = read_edge_list(kr_str_PATH_, kb_DIRECTED_, kr_PARSE_OPTIONS_);
+
+    CSRGraph csr(edges, kr_CSR_OPTIONS_);
+
+    // the numbering of the file against the snapshot's, only the
+    // snapshot is built
+    if (VertexOrder::NONE != kr_CSR_OPTIONS_.m_order)
+    {
+        const CSRGraph::Locality k_BEFORE = CSRGraph::locality(edges);
+        const CSRGraph::Locality k_AFTER = csr.locality();
+
+        LOG_F(INFO, "Mean log2 neighbor gap %.2f -> %.2f, bandwidth %zu -> %zu",
+            k_BEFORE.md_mean_log_gap, k_AFTER.md_mean_log_gap, k_BEFORE.mu_li_bandwidth, k_AFTER.mu_li_bandwidth);
+    } // end if
+
+    return csr;
+} // end method read_graph
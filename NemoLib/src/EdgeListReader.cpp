@@ -0,0 +1,1021 @@
+#include <algorithm>     // shuffle, sort, remove_if, min, max, all_of, lower_bound, unique
+#include <array>         // array
+#include <cctype>        // isspace
+#include <charconv>      // from_chars
+#include <numeric>       // partial_sum
+#include <system_error>  // errc
+#include <type_traits>   // remove_reference_t
+#include <cerrno>        // errno
+#include <cstring>       // memchr, strerror
+#include <functional>    // hash
+#include <random>        // mt19937_64
+#include <stdexcept>     // invalid_argument
+#include <string>        // to_string
+#include <string_view>   // string_view
+#include <thread>        // thread, hardware_concurrency
+#include <unordered_map> // unordered_map
+
+#include <fcntl.h>     // open, O_RDONLY
+#include <unistd.h>    // close
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+
+#include "EdgeListReader.hpp"
+#include "Utility.hpp" // RNG_provider
+
+
+namespace
+{
+    //! smallest chunk worth a thread of its own
+    constexpr std::size_t ku_li_MIN_CHUNK_BYTES = std::size_t{1} << 20;
+
+
+    /** @brief The names and edges of one chunk of the file.*/
+    struct Chunk
+    {
+        //! distinct names in order of first appearance, local id is the index
+        std::vector<std::string_view> vect_names;
+        //! local ids of the names of every shard
+        std::vector<std::vector<std::uint32_t>> vect_by_shard;
+        //! edges between local ids
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> vect_edges;
+        //! number of every local id in the whole file
+        std::vector<vertex> vect_global;
+
+        //! edges between integer names, or between their keys once they
+        //! are ranked
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> vect_id_edges;
+        //! largest integer name
+        std::uint64_t u_max_id = 0;
+        //! first name that is not an integer, empty if there is none
+        std::string_view sv_not_integer;
+    }; // end struct Chunk
+
+
+    /** @brief Runs f(0), ..., f(n - 1) on n threads, the last on the caller.*/
+    template <typename F>
+    void run_parallel(const std::size_t ku_li_N_, F&& f_)
+    {
+        std::vector<std::thread> vect_threads;
+
+        for (std::size_t t{0}; t + 1 < ku_li_N_; t++)
+        {
+            vect_threads.emplace_back([&f_, t]{ f_(t); });
+        } // end for t
+
+        if (ku_li_N_ > 0)
+        {
+            f_(ku_li_N_ - 1);
+        } // end if
+
+        for (auto& r_thread : vect_threads)
+        {
+            r_thread.join();
+        } // end for r_thread
+    } // end method run_parallel
+
+
+    constexpr bool is_blank(const char k_C_) noexcept
+    {
+        return ' ' == k_C_ || '\t' == k_C_ || '\r' == k_C_;
+    } // end method is_blank
+
+
+    /** @brief Takes the next whitespace separated token of a line.*/
+    std::string_view next_token(const char*& rp_it_, const char* p_end_) noexcept
+    {
+        while (rp_it_ < p_end_ && is_blank(*rp_it_))
+        {
+            rp_it_++;
+        } // end while
+
+        const char* p_begin = rp_it_;
+
+        while (rp_it_ < p_end_ && false == is_blank(*rp_it_))
+        {
+            rp_it_++;
+        } // end while
+
+        return std::string_view(p_begin, static_cast<std::size_t>(rp_it_ - p_begin));
+    } // end method next_token
+
+
+    /** @brief Tokenizes the lines of a chunk and numbers its names locally.*/
+    void tokenize(const char* p_begin_, const char* p_end_, const std::size_t ku_li_SHARDS_, Chunk& r_chunk_)
+    {
+        std::unordered_map<std::string_view, std::uint32_t> umap_local;
+        const std::hash<std::string_view> k_hash{};
+
+        r_chunk_.vect_by_shard.resize(ku_li_SHARDS_);
+
+        auto local_id = [&](const std::string_view k_NAME_)
+        {
+            auto [it, b_new] = umap_local.emplace(k_NAME_, static_cast<std::uint32_t>(r_chunk_.vect_names.size()));
+
+            if (true == b_new)
+            {
+                r_chunk_.vect_by_shard[k_hash(k_NAME_) % ku_li_SHARDS_].push_back(it->second);
+                r_chunk_.vect_names.push_back(k_NAME_);
+            } // end if
+
+            return it->second;
+        }; // end lambda
+
+        for (const char* p_line = p_begin_; p_line < p_end_; )
+        {
+            const char* p_eol = static_cast<const char*>(std::memchr(p_line, '\n', static_cast<std::size_t>(p_end_ - p_line)));
+
+            if (nullptr == p_eol)
+            {
+                p_eol = p_end_;
+            } // end if
+
+            const char* p_it = p_line;
+            const std::string_view k_from = next_token(p_it, p_eol);
+            const std::string_view k_to = next_token(p_it, p_eol);
+
+            if (false == k_to.empty())
+            {
+                const std::uint32_t ku_from = local_id(k_from);
+                r_chunk_.vect_edges.emplace_back(ku_from, local_id(k_to));
+            } // end if
+
+            p_line = p_eol + 1;
+        } // end for p_line
+    } // end method tokenize
+
+
+    /** @brief Parses a name that is a plain decimal integer, without a sign
+      *        or a leading zero.
+      */
+    bool parse_id(const std::string_view k_NAME_, std::uint64_t& r_u_id_) noexcept
+    {
+        if (true == k_NAME_.empty() || (k_NAME_.size() > 1 && '0' == k_NAME_.front()))
+        {
+            return false;
+        } // end if
+
+        const char* p_end = k_NAME_.data() + k_NAME_.size();
+        const std::from_chars_result k_result = std::from_chars(k_NAME_.data(), p_end, r_u_id_);
+
+        return std::errc() == k_result.ec && p_end == k_result.ptr;
+    } // end method parse_id
+
+
+    /** @brief Tokenizes the lines of a chunk whose names are all integers.
+      * @return false, with the offending name, at the first name that isn't
+      */
+    bool tokenize_ids(const char* p_begin_, const char* p_end_, Chunk& r_chunk_)
+    {
+        for (const char* p_line = p_begin_; p_line < p_end_; )
+        {
+            const char* p_eol = static_cast<const char*>(std::memchr(p_line, '\n', static_cast<std::size_t>(p_end_ - p_line)));
+
+            if (nullptr == p_eol)
+            {
+                p_eol = p_end_;
+            } // end if
+
+            const char* p_it = p_line;
+            const std::string_view k_from = next_token(p_it, p_eol);
+            const std::string_view k_to = next_token(p_it, p_eol);
+
+            if (false == k_to.empty())
+            {
+                std::uint64_t u_from{0}, u_to{0};
+
+                if (false == parse_id(k_from, u_from) || false == parse_id(k_to, u_to))
+                {
+                    r_chunk_.sv_not_integer = parse_id(k_from, u_from) ? k_to : k_from;
+                    r_chunk_.vect_id_edges = {};
+                    return false;
+                } // end if
+
+                r_chunk_.u_max_id = std::max({r_chunk_.u_max_id, u_from, u_to});
+                r_chunk_.vect_id_edges.emplace_back(u_from, u_to);
+            } // end if
+
+            p_line = p_eol + 1;
+        } // end for p_line
+
+        return true;
+    } // end method tokenize_ids
+
+
+    /** @brief Sorts integers a byte at a time, least significant first.
+      * @remark Bytes that are the same in every integer are skipped, so
+      *         small integers take as many passes as they have bytes.
+      */
+    void radix_sort(std::vector<std::uint64_t>& r_vect_keys_)
+    {
+        std::vector<std::uint64_t> vect_buffer(r_vect_keys_.size());
+
+        for (unsigned u_shift{0}; u_shift < 64; u_shift += 8)
+        {
+            std::array<std::size_t, 257> arr_starts{};
+
+            for (const std::uint64_t ku_key : r_vect_keys_)
+            {
+                arr_starts[((ku_key >> u_shift) & 0xFF) + 1]++;
+            } // end for ku_key
+
+            if (std::any_of(arr_starts.begin(), arr_starts.end(),
+                    [&](const std::size_t ku_li_COUNT_){ return ku_li_COUNT_ == r_vect_keys_.size(); }))
+            {
+                continue;
+            } // end if
+
+            std::partial_sum(arr_starts.begin(), arr_starts.end(), arr_starts.begin());
+
+            for (const std::uint64_t ku_key : r_vect_keys_)
+            {
+                vect_buffer[arr_starts[(ku_key >> u_shift) & 0xFF]++] = ku_key;
+            } // end for ku_key
+
+            r_vect_keys_.swap(vect_buffer);
+        } // end for u_shift
+    } // end method radix_sort
+
+
+    /** @brief Numbers the integer names of all chunks by their first
+      *        appearance in the file and assembles the edges.
+      */
+    void number_ids(std::vector<Chunk>& r_vect_chunks_, EdgeList& r_edges_)
+    {
+        std::size_t u_li_ends{0};
+        std::uint64_t u_max_id{0};
+
+        for (const auto& kr_chunk : r_vect_chunks_)
+        {
+            u_li_ends += 2 * kr_chunk.vect_id_edges.size();
+            u_max_id = std::max(u_max_id, kr_chunk.u_max_id);
+        } // end for kr_chunk
+
+        // integers sparser than one per few edge ends are first ranked
+        // among the distinct integers, so that the flat array stays small
+        std::vector<std::uint64_t> vect_distinct;
+        const bool kb_flat = u_max_id / 4 < u_li_ends;
+
+        if (false == kb_flat)
+        {
+            vect_distinct.reserve(u_li_ends);
+
+            for (const auto& kr_chunk : r_vect_chunks_)
+            {
+                for (const auto& kr_edge : kr_chunk.vect_id_edges)
+                {
+                    vect_distinct.push_back(kr_edge.first);
+                    vect_distinct.push_back(kr_edge.second);
+                } // end for kr_edge
+            } // end for kr_chunk
+
+            radix_sort(vect_distinct);
+            vect_distinct.erase(std::unique(vect_distinct.begin(), vect_distinct.end()), vect_distinct.end());
+
+            run_parallel(r_vect_chunks_.size(), [&](const std::size_t c)
+            {
+                auto rank = [&](const std::uint64_t ku_ID_)
+                {
+                    return static_cast<std::uint64_t>(std::lower_bound(vect_distinct.begin(), vect_distinct.end(), ku_ID_) - vect_distinct.begin());
+                }; // end lambda
+
+                for (auto& r_edge : r_vect_chunks_[c].vect_id_edges)
+                {
+                    r_edge = {rank(r_edge.first), rank(r_edge.second)};
+                } // end for r_edge
+            }); // end run_parallel
+        } // end if
+
+        std::vector<vertex> vect_numbers(kb_flat ? u_max_id + 1 : vect_distinct.size(), NILLVERTEX);
+
+        auto number = [&](const std::uint64_t ku_KEY_)
+        {
+            if (NILLVERTEX == vect_numbers[ku_KEY_])
+            {
+                vect_numbers[ku_KEY_] = static_cast<vertex>(r_edges_.m_vect_ids.size());
+                r_edges_.m_vect_ids.push_back(kb_flat ? ku_KEY_ : vect_distinct[ku_KEY_]);
+            } // end if
+
+            return vect_numbers[ku_KEY_];
+        }; // end lambda
+
+        r_edges_.m_vect_edges.reserve(u_li_ends / 2);
+
+        for (auto& r_chunk : r_vect_chunks_)
+        {
+            for (const auto& kr_edge : r_chunk.vect_id_edges)
+            {
+                const vertex k_from = number(kr_edge.first);
+                r_edges_.m_vect_edges.emplace_back(k_from, number(kr_edge.second));
+            } // end for kr_edge
+
+            r_chunk.vect_id_edges = {};
+        } // end for r_chunk
+
+        r_edges_.mu_li_vertices = r_edges_.m_vect_ids.size();
+    } // end method number_ids
+
+
+    /** @brief Numbers the names of all chunks by their first appearance in
+      *        the file and copies each name once into the name table.
+      */
+    void intern(std::vector<Chunk>& r_vect_chunks_, const std::size_t ku_li_SHARDS_, std::vector<std::string>& r_vect_names_)
+    {
+        //! first appearance of every name of a shard, chunk in the high half
+        std::vector<std::unordered_map<std::string_view, std::uint64_t>> vect_shards(ku_li_SHARDS_);
+
+        // chunks are visited in file order and local ids ascend within a
+        // chunk, so the first insert of a name is its first appearance
+        run_parallel(ku_li_SHARDS_, [&](const std::size_t s)
+        {
+            for (std::size_t c{0}; c < r_vect_chunks_.size(); c++)
+            {
+                for (const std::uint32_t l : r_vect_chunks_[c].vect_by_shard[s])
+                {
+                    vect_shards[s].emplace(r_vect_chunks_[c].vect_names[l], (std::uint64_t{c} << 32) | l);
+                } // end for l
+            } // end for c
+        }); // end run_parallel
+
+        std::vector<std::uint64_t> vect_firsts;
+
+        for (const auto& kr_shard : vect_shards)
+        {
+            for (const auto& kr_entry : kr_shard)
+            {
+                vect_firsts.push_back(kr_entry.second);
+            } // end for kr_entry
+        } // end for kr_shard
+
+        std::sort(vect_firsts.begin(), vect_firsts.end());
+
+        for (auto& r_chunk : r_vect_chunks_)
+        {
+            r_chunk.vect_global.resize(r_chunk.vect_names.size());
+        } // end for r_chunk
+
+        r_vect_names_.resize(vect_firsts.size());
+
+        run_parallel(ku_li_SHARDS_, [&](const std::size_t s)
+        {
+            for (std::size_t g{s}; g < vect_firsts.size(); g += ku_li_SHARDS_)
+            {
+                Chunk& r_chunk = r_vect_chunks_[vect_firsts[g] >> 32];
+                const std::uint32_t ku_local = static_cast<std::uint32_t>(vect_firsts[g] & 0xFFFFFFFFull);
+
+                r_chunk.vect_global[ku_local] = static_cast<vertex>(g);
+                r_vect_names_[g] = std::string(r_chunk.vect_names[ku_local]);
+            } // end for g
+        }); // end run_parallel
+
+        // every other appearance takes the number of the first
+        run_parallel(ku_li_SHARDS_, [&](const std::size_t s)
+        {
+            for (auto& r_chunk : r_vect_chunks_)
+            {
+                for (const std::uint32_t l : r_chunk.vect_by_shard[s])
+                {
+                    const std::uint64_t ku_first = vect_shards[s].at(r_chunk.vect_names[l]);
+
+                    r_chunk.vect_global[l] = r_vect_chunks_[ku_first >> 32].vect_global[ku_first & 0xFFFFFFFFull];
+                } // end for l
+            } // end for r_chunk
+        }); // end run_parallel
+    } // end method intern
+
+
+    /** @brief Drops the edges from a vertex to itself.*/
+    void remove_self_edges(EdgeList& r_edges_)
+    {
+        r_edges_.m_vect_edges.erase(std::remove_if(r_edges_.m_vect_edges.begin(), r_edges_.m_vect_edges.end(),
+            [](const std::pair<vertex, vertex>& kr_EDGE_)
+            {
+                return kr_EDGE_.first == kr_EDGE_.second;
+            } // end lambda
+        ), r_edges_.m_vect_edges.end());
+    } // end method remove_self_edges
+
+
+    /** @brief The members of the graph6 family, @see
+      *        https://users.cecs.anu.edu.au/~bdm/data/formats.txt
+      */
+    enum class Graph6Format
+    {
+        //! not a graph6 family file, a text edge list
+        NONE,
+        GRAPH6,
+        SPARSE6,
+        DIGRAPH6
+    }; // end enum Graph6Format
+
+
+    //! graph6 characters carry six bits each, offset by 63
+    constexpr unsigned char ku_G6_BIAS = 63;
+
+
+    constexpr bool is_g6_char(const unsigned char k_C_) noexcept
+    {
+        return k_C_ >= ku_G6_BIAS && k_C_ <= 126;
+    } // end method is_g6_char
+
+
+    /** @brief Decodes the vertex count N(n) at the start of a graph6 string.
+      * @throws std::invalid_argument If the string ends inside N(n), holds
+      *         a byte outside 63..126 there or n exceeds the vertex range.
+      */
+    std::size_t decode_order(const unsigned char*& rp_it_, const unsigned char* p_end_)
+    {
+        // one byte up to 62 vertices, three more up to 2^18 - 1, six
+        // more past that
+        std::size_t u_li_bytes{1};
+
+        if (rp_it_ < p_end_ && 126 == *rp_it_)
+        {
+            rp_it_++;
+            u_li_bytes = (rp_it_ < p_end_ && 126 == *rp_it_) ? (rp_it_++, 6) : 3;
+        } // end if
+
+        if (static_cast<std::size_t>(p_end_ - rp_it_) < u_li_bytes)
+        {
+            throw std::invalid_argument("graph6 string is truncated in its vertex count");
+        } // end if
+
+        std::size_t u_li_n{0};
+
+        for (std::size_t b{0}; b < u_li_bytes; b++)
+        {
+            if (false == is_g6_char(*rp_it_))
+            {
+                throw std::invalid_argument("graph6 vertex count holds the invalid byte " + std::to_string(static_cast<unsigned>(*rp_it_)));
+            } // end if
+
+            u_li_n = (u_li_n << 6) | static_cast<std::size_t>(*rp_it_++ - ku_G6_BIAS);
+        } // end for b
+
+        // vertices are numbered 0..n-1 and NILLVERTEX is reserved
+        if (u_li_n > static_cast<std::size_t>(NILLVERTEX))
+        {
+            throw std::invalid_argument("graph6 vertex count " + std::to_string(u_li_n) + " exceeds the vertex range");
+        } // end if
+
+        return u_li_n;
+    } // end method decode_order
+
+
+    /** @brief Which graph6 format a file is in, judged by its first line.
+      * @param rp_it_ Moved past the header and the format prefix if the
+      *        file is in one
+      * @param rp_end_ Set to the end of the first line if the file is in one
+      * @remark A header may be alone on its line, the graph is then read
+      *         from the next one.
+      * @throws std::invalid_argument If a header isn't followed by a graph.
+      */
+    Graph6Format sniff_graph6(const unsigned char*& rp_it_, const unsigned char*& rp_end_)
+    {
+        static const std::pair<std::string_view, Graph6Format> ks_arr_HEADERS[] = {
+            {">>graph6<<", Graph6Format::GRAPH6},
+            {">>sparse6<<", Graph6Format::SPARSE6},
+            {">>digraph6<<", Graph6Format::DIGRAPH6}
+        };
+
+        const unsigned char* p_it = rp_it_;
+        const std::string_view k_file(reinterpret_cast<const char*>(p_it), static_cast<std::size_t>(rp_end_ - p_it));
+        Graph6Format format = Graph6Format::NONE;
+
+        for (const auto& kr_header : ks_arr_HEADERS)
+        {
+            if (0 == k_file.compare(0, kr_header.first.size(), kr_header.first))
+            {
+                p_it += kr_header.first.size();
+                format = kr_header.second;
+            } // end if
+        } // end for kr_header
+
+        auto end_of_line = [&rp_end_](const unsigned char* p_from_)
+        {
+            while (p_from_ < rp_end_ && '\n' != *p_from_ && '\r' != *p_from_)
+            {
+                p_from_++;
+            } // end while
+
+            return p_from_;
+        }; // end lambda
+
+        const unsigned char* p_eol = end_of_line(p_it);
+
+        // a header alone on its line, the graph starts on the next
+        if (Graph6Format::NONE != format && p_it == p_eol)
+        {
+            if (p_it < rp_end_ && '\r' == *p_it)
+            {
+                p_it++;
+            } // end if
+
+            if (p_it < rp_end_ && '\n' == *p_it)
+            {
+                p_it++;
+            } // end if
+
+            p_eol = end_of_line(p_it);
+
+            if (p_it == p_eol)
+            {
+                throw std::invalid_argument("The graph6 header is not followed by a graph");
+            } // end if
+        } // end if
+
+        if (p_it == p_eol)
+        {
+            return Graph6Format::NONE;
+        } // end if
+
+        if (';' == *p_it)
+        {
+            throw std::invalid_argument("Incremental sparse6 files are not supported");
+        } // end if
+
+        const Graph6Format k_prefixed = (':' == *p_it) ? Graph6Format::SPARSE6 : ('&' == *p_it) ? Graph6Format::DIGRAPH6 : Graph6Format::GRAPH6;
+        const unsigned char* p_body = (Graph6Format::GRAPH6 == k_prefixed) ? p_it : p_it + 1;
+
+        // an edge list line has a blank between its vertices, so a line of
+        // graph6 characters only can't be one
+        if (false == std::all_of(p_body, p_eol, is_g6_char))
+        {
+            if (Graph6Format::NONE != format)
+            {
+                throw std::invalid_argument("The graph6 header is followed by a line that isn't in a graph6 format");
+            } // end if
+
+            return Graph6Format::NONE;
+        } // end if
+
+        // without a header or prefix the line also has to be exactly as
+        // long as its vertex count calls for
+        if (Graph6Format::NONE == format && Graph6Format::GRAPH6 == k_prefixed)
+        {
+            const unsigned char* p_bits = p_body;
+            std::size_t u_li_n{0};
+
+            try
+            {
+                u_li_n = decode_order(p_bits, p_eol);
+            } // end try
+            catch (const std::invalid_argument&)
+            {
+                return Graph6Format::NONE;
+            } // end catch
+
+            if (static_cast<std::size_t>(p_eol - p_bits) != (u_li_n * (u_li_n - (u_li_n > 0)) / 2 + 5) / 6)
+            {
+                return Graph6Format::NONE;
+            } // end if
+        } // end if
+
+        rp_it_ = p_body;
+        rp_end_ = p_eol;
+
+        return k_prefixed;
+    } // end method sniff_graph6
+
+
+    /** @brief Decodes the upper triangle of a graph6 string, column by
+      *        column, skipping characters without any bit set.
+      */
+    void decode_graph6(const unsigned char* p_it_, const unsigned char* p_end_, EdgeList& r_edges_)
+    {
+        const std::size_t ku_li_n = r_edges_.mu_li_vertices;
+
+        // the pair (i, j), i < j, the next bit stands for
+        std::size_t u_li_i{0}, u_li_j{1};
+
+        auto advance = [&](const std::size_t ku_li_BITS_)
+        {
+            u_li_i += ku_li_BITS_;
+
+            while (u_li_j < ku_li_n && u_li_i >= u_li_j)
+            {
+                u_li_i -= u_li_j;
+                u_li_j++;
+            } // end while
+        }; // end lambda
+
+        for (; p_it_ < p_end_ && u_li_j < ku_li_n; p_it_++)
+        {
+            const unsigned k_bits = *p_it_ - ku_G6_BIAS;
+
+            if (0 == k_bits)
+            {
+                advance(6);
+                continue;
+            } // end if
+
+            for (int b{5}; b >= 0 && u_li_j < ku_li_n; b--)
+            {
+                if (0 != ((k_bits >> b) & 1))
+                {
+                    r_edges_.m_vect_edges.emplace_back(static_cast<vertex>(u_li_i), static_cast<vertex>(u_li_j));
+                } // end if
+
+                advance(1);
+            } // end for b
+        } // end for p_it_
+
+        if (u_li_j < ku_li_n)
+        {
+            throw std::invalid_argument("graph6 string is truncated");
+        } // end if
+    } // end method decode_graph6
+
+
+    /** @brief Decodes the n x n adjacency matrix of a digraph6 string, row
+      *        by row, an edge from the row to the column for every bit set.
+      */
+    void decode_digraph6(const unsigned char* p_it_, const unsigned char* p_end_, EdgeList& r_edges_)
+    {
+        const std::size_t ku_li_n = r_edges_.mu_li_vertices;
+        const std::size_t ku_li_bits = ku_li_n * ku_li_n;
+
+        if (static_cast<std::size_t>(p_end_ - p_it_) * 6 < ku_li_bits)
+        {
+            throw std::invalid_argument("digraph6 string is truncated");
+        } // end if
+
+        for (std::size_t u_li_bit{0}; u_li_bit < ku_li_bits; p_it_++, u_li_bit += 6)
+        {
+            const unsigned k_bits = *p_it_ - ku_G6_BIAS;
+
+            for (int b{5}; b >= 0 && 0 != k_bits; b--)
+            {
+                const std::size_t ku_li_at = u_li_bit + static_cast<std::size_t>(5 - b);
+
+                if (0 != ((k_bits >> b) & 1) && ku_li_at < ku_li_bits)
+                {
+                    r_edges_.m_vect_edges.emplace_back(static_cast<vertex>(ku_li_at / ku_li_n), static_cast<vertex>(ku_li_at % ku_li_n));
+                } // end if
+            } // end for b
+        } // end for u_li_bit
+    } // end method decode_digraph6
+
+
+    /** @brief Decodes the (b, x) records of a sparse6 string.
+      * @remark Every record is one bit b, set to step to the next vertex v,
+      *         and k bits of a vertex x, where 2^k is the smallest power of
+      *         two of at least n. An x above v jumps v to it, anything else
+      *         is the edge {x, v}. The padding of the last character is all
+      *         ones, so a record running past n ends the string.
+      */
+    void decode_sparse6(const unsigned char* p_it_, const unsigned char* p_end_, EdgeList& r_edges_)
+    {
+        const std::size_t ku_li_n = r_edges_.mu_li_vertices;
+
+        unsigned u_k{1};
+
+        while ((std::size_t{1} << u_k) < ku_li_n)
+        {
+            u_k++;
+        } // end while
+
+        // bits of the current character not yet read
+        std::uint64_t u_window{0};
+        unsigned u_window_bits{0};
+
+        auto read_bits = [&](const unsigned ku_BITS_, std::size_t& r_u_li_value_)
+        {
+            while (u_window_bits < ku_BITS_)
+            {
+                if (p_it_ == p_end_)
+                {
+                    return false;
+                } // end if
+
+                u_window = (u_window << 6) | (*p_it_++ - ku_G6_BIAS);
+                u_window_bits += 6;
+            } // end while
+
+            u_window_bits -= ku_BITS_;
+            r_u_li_value_ = static_cast<std::size_t>((u_window >> u_window_bits) & ((std::uint64_t{1} << ku_BITS_) - 1));
+            u_window &= (std::uint64_t{1} << u_window_bits) - 1;
+
+            return true;
+        }; // end lambda
+
+        std::size_t u_li_v{0}, u_li_b{0}, u_li_x{0};
+
+        while (true == read_bits(1, u_li_b) && true == read_bits(u_k, u_li_x))
+        {
+            u_li_v += u_li_b;
+
+            if (u_li_x >= ku_li_n || u_li_v >= ku_li_n)
+            {
+                break;
+            } // end if
+
+            if (u_li_x > u_li_v)
+            {
+                u_li_v = u_li_x;
+            } // end if
+            else
+            {
+                r_edges_.m_vect_edges.emplace_back(static_cast<vertex>(u_li_x), static_cast<vertex>(u_li_v));
+            } // end else
+        } // end while
+    } // end method decode_sparse6
+
+
+    /** @brief Decodes the graph6 family string of a file, throws if another
+      *        graph follows it.
+      */
+    void read_graph6(const Graph6Format k_FORMAT_, const unsigned char* p_it_, const unsigned char* p_eol_, const unsigned char* p_end_, EdgeList& r_edges_)
+    {
+        r_edges_.m_b_directed = (Graph6Format::DIGRAPH6 == k_FORMAT_);
+        r_edges_.mu_li_vertices = decode_order(p_it_, p_eol_);
+
+        switch (k_FORMAT_)
+        {
+            case Graph6Format::GRAPH6:   decode_graph6(p_it_, p_eol_, r_edges_); break;
+            case Graph6Format::SPARSE6:  decode_sparse6(p_it_, p_eol_, r_edges_); break;
+            case Graph6Format::DIGRAPH6: decode_digraph6(p_it_, p_eol_, r_edges_); break;
+            case Graph6Format::NONE:     break;
+        } // end switch
+
+        if (false == std::all_of(p_eol_, p_end_, [](const unsigned char k_C_){ return std::isspace(k_C_); }))
+        {
+            throw std::invalid_argument("Only the first graph of a graph6 file can be read, the file holds more");
+        } // end if
+    } // end method read_graph6
+
+
+    /** @brief Shuffles the edges and renumbers the vertices by their first
+      *        appearance in the shuffled order.
+      */
+    void shuffle_edges(EdgeList& r_edges_, const std::uint64_t ku_SEED_)
+    {
+        std::mt19937_64 rng(0 == ku_SEED_ ? RNG_provider()() : ku_SEED_);
+
+        std::shuffle(r_edges_.m_vect_edges.begin(), r_edges_.m_vect_edges.end(), rng);
+
+        std::vector<vertex> vect_renumbered(r_edges_.mu_li_vertices, NILLVERTEX);
+        vertex next{0};
+
+        auto renumber = [&](vertex& r_v_)
+        {
+            if (NILLVERTEX == vect_renumbered[r_v_])
+            {
+                vect_renumbered[r_v_] = next++;
+            } // end if
+
+            r_v_ = vect_renumbered[r_v_];
+        }; // end lambda
+
+        for (auto& r_edge : r_edges_.m_vect_edges)
+        {
+            renumber(r_edge.first);
+            renumber(r_edge.second);
+        } // end for r_edge
+
+        auto permute = [&](auto& r_vect_names_)
+        {
+            std::remove_reference_t<decltype(r_vect_names_)> vect_permuted(r_vect_names_.size());
+
+            for (std::size_t v{0}; v < vect_permuted.size(); v++)
+            {
+                vect_permuted[vect_renumbered[v]] = std::move(r_vect_names_[v]);
+            } // end for v
+
+            r_vect_names_ = std::move(vect_permuted);
+        }; // end lambda
+
+        permute(r_edges_.m_vect_names);
+        permute(r_edges_.m_vect_ids);
+    } // end method shuffle_edges
+} // end namespace
+
+
+VertexIds parse_vertex_ids(const std::string& kr_str_NAME_)
+{
+    if ("auto" == kr_str_NAME_)
+    {
+        return VertexIds::AUTO;
+    } // end if
+    else if ("numeric" == kr_str_NAME_)
+    {
+        return VertexIds::NUMERIC;
+    } // end elif
+    else if ("names" == kr_str_NAME_)
+    {
+        return VertexIds::NAMES;
+    } // end elif
+
+    throw std::invalid_argument("Unknown vertex id mode '" + kr_str_NAME_ + "', expected auto, numeric or names");
+} // end method parse_vertex_ids
+
+
+std::vector<std::string> vertex_names(const EdgeList& kr_EDGES_)
+{
+    if (false == kr_EDGES_.m_vect_names.empty())
+    {
+        return kr_EDGES_.m_vect_names;
+    } // end if
+
+    std::vector<std::string> vect_names;
+    vect_names.reserve(kr_EDGES_.m_vect_ids.size());
+
+    for (const std::uint64_t ku_id : kr_EDGES_.m_vect_ids)
+    {
+        vect_names.push_back(std::to_string(ku_id));
+    } // end for ku_id
+
+    return vect_names;
+} // end method vertex_names
+
+
+void parse_shuffle(const std::string& kr_str_MODE_, ParseOptions& r_options_)
+{
+    if ("on" == kr_str_MODE_ || "off" == kr_str_MODE_)
+    {
+        r_options_.m_b_shuffle = ("on" == kr_str_MODE_);
+        r_options_.mu_seed = 0;
+        return;
+    } // end if
+
+    std::size_t u_li_end{0};
+
+    try
+    {
+        r_options_.mu_seed = std::stoull(kr_str_MODE_, &u_li_end);
+    } // end try
+    catch (const std::exception&)
+    {
+        u_li_end = 0;
+    } // end catch
+
+    if (u_li_end != kr_str_MODE_.size() || 0 == r_options_.mu_seed)
+    {
+        throw std::invalid_argument("Unknown shuffle mode '" + kr_str_MODE_ + "', expected on, off or a nonzero seed");
+    } // end if
+
+    r_options_.m_b_shuffle = true;
+} // end method parse_shuffle
+
+
+EdgeList read_edge_list(const std::string& kr_str_PATH_, const bool kb_DIRECTED_, const ParseOptions& kr_OPTIONS_)
+{
+    const int k_fd = open(kr_str_PATH_.c_str(), O_RDONLY);
+
+    if (-1 == k_fd)
+    {
+        throw std::invalid_argument("Cannot find an input file '" + kr_str_PATH_ + "': " + std::strerror(errno));
+    } // end if
+
+    struct stat file_stat;
+
+    if (-1 == fstat(k_fd, &file_stat))
+    {
+        close(k_fd);
+        throw std::invalid_argument("Cannot stat the input file '" + kr_str_PATH_ + "'");
+    } // end if
+
+    const std::size_t ku_li_size = static_cast<std::size_t>(file_stat.st_size);
+
+    EdgeList edges;
+    edges.m_b_directed = kb_DIRECTED_;
+
+    if (0 == ku_li_size)
+    {
+        close(k_fd);
+        return edges;
+    } // end if
+
+    void* p_map = mmap(nullptr, ku_li_size, PROT_READ, MAP_PRIVATE, k_fd, 0);
+
+    // the mapping stays valid once the descriptor is closed
+    close(k_fd);
+
+    if (MAP_FAILED == p_map)
+    {
+        throw std::invalid_argument("Cannot map the input file '" + kr_str_PATH_ + "'");
+    } // end if
+
+    madvise(p_map, ku_li_size, MADV_SEQUENTIAL);
+
+    const char* p_file = static_cast<const char*>(p_map);
+
+    const unsigned char* p_g6 = static_cast<const unsigned char*>(p_map);
+    const unsigned char* p_g6_eol = p_g6 + ku_li_size;
+    const Graph6Format k_g6_format = sniff_graph6(p_g6, p_g6_eol);
+
+    if (Graph6Format::NONE != k_g6_format)
+    {
+        try
+        {
+            read_graph6(k_g6_format, p_g6, p_g6_eol, static_cast<const unsigned char*>(p_map) + ku_li_size, edges);
+        } // end try
+        catch (...)
+        {
+            munmap(p_map, ku_li_size);
+            throw;
+        } // end catch
+
+        munmap(p_map, ku_li_size);
+
+        remove_self_edges(edges);
+
+        return edges;
+    } // end if
+
+    const std::size_t ku_li_threads = std::max<std::size_t>(1,
+        0 == kr_OPTIONS_.mu_li_threads ? std::thread::hardware_concurrency() : kr_OPTIONS_.mu_li_threads);
+    const std::size_t ku_li_chunks = std::min(ku_li_threads, ku_li_size / ku_li_MIN_CHUNK_BYTES + 1);
+
+    // chunks end on line boundaries
+    std::vector<const char*> vect_bounds{p_file};
+
+    for (std::size_t c{1}; c < ku_li_chunks; c++)
+    {
+        const char* p_bound = std::max(vect_bounds.back(), p_file + ku_li_size * c / ku_li_chunks);
+        const void* p_eol = std::memchr(p_bound, '\n', static_cast<std::size_t>(p_file + ku_li_size - p_bound));
+
+        vect_bounds.push_back(nullptr == p_eol ? p_file + ku_li_size : static_cast<const char*>(p_eol) + 1);
+    } // end for c
+
+    vect_bounds.push_back(p_file + ku_li_size);
+
+    std::vector<Chunk> vect_chunks(ku_li_chunks);
+
+    // integer names are tried first, a single other name anywhere sends
+    // the whole file through the name maps
+    bool b_integers = (VertexIds::NAMES != kr_OPTIONS_.m_ids);
+
+    if (true == b_integers)
+    {
+        std::vector<char> vect_integers(ku_li_chunks);
+
+        run_parallel(ku_li_chunks, [&](const std::size_t c)
+        {
+            vect_integers[c] = tokenize_ids(vect_bounds[c], vect_bounds[c + 1], vect_chunks[c]);
+        }); // end run_parallel
+
+        b_integers = std::all_of(vect_integers.begin(), vect_integers.end(), [](const char kb_INTEGERS_){ return kb_INTEGERS_; });
+    } // end if
+
+    if (false == b_integers && VertexIds::NUMERIC == kr_OPTIONS_.m_ids)
+    {
+        auto it = std::find_if(vect_chunks.begin(), vect_chunks.end(),
+            [](const Chunk& kr_CHUNK_){ return false == kr_CHUNK_.sv_not_integer.empty(); });
+        const std::string k_str_name(it->sv_not_integer);
+
+        munmap(p_map, ku_li_size);
+        throw std::invalid_argument("Vertex name '" + k_str_name + "' in '" + kr_str_PATH_ + "' is not an integer");
+    } // end if
+
+    if (true == b_integers)
+    {
+        number_ids(vect_chunks, edges);
+    } // end if
+    else
+    {
+        run_parallel(ku_li_chunks, [&](const std::size_t c)
+        {
+            vect_chunks[c].vect_id_edges = {};
+            tokenize(vect_bounds[c], vect_bounds[c + 1], ku_li_chunks, vect_chunks[c]);
+        }); // end run_parallel
+
+        intern(vect_chunks, ku_li_chunks, edges.m_vect_names);
+        edges.mu_li_vertices = edges.m_vect_names.size();
+
+        // the edges of every chunk go to their place in file order
+        std::vector<std::size_t> vect_starts{0};
+
+        for (const auto& kr_chunk : vect_chunks)
+        {
+            vect_starts.push_back(vect_starts.back() + kr_chunk.vect_edges.size());
+        } // end for kr_chunk
+
+        edges.m_vect_edges.resize(vect_starts.back());
+
+        run_parallel(ku_li_chunks, [&](const std::size_t c)
+        {
+            const Chunk& kr_chunk = vect_chunks[c];
+
+            for (std::size_t e{0}; e < kr_chunk.vect_edges.size(); e++)
+            {
+                edges.m_vect_edges[vect_starts[c] + e] = {kr_chunk.vect_global[kr_chunk.vect_edges[e].first],
+                                                          kr_chunk.vect_global[kr_chunk.vect_edges[e].second]};
+            } // end for e
+        }); // end run_parallel
+    } // end else
+
+    // the names have been copied out of the mapping
+    munmap(p_map, ku_li_size);
+
+    if (true == kr_OPTIONS_.m_b_shuffle)
+    {
+        shuffle_edges(edges, kr_OPTIONS_.mu_seed);
+    } // end if
+
+    // self edges still name their vertex, so they are only dropped once
+    // every vertex is numbered
+    remove_self_edges(edges);
+
+    return edges;
+} // end method read_edge_list
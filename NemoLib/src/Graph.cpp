@@ -9,10 +9,7 @@
  */
 
 #include "Graph.hpp"		// class header
-#include <sstream>		// stringstream
-#include <algorithm>	// shuffle
-#include <fstream>		// ifstream
-#include "Utility.hpp"	// RNG_provider
+#include <algorithm>	// find
 
 using std::string;
 using std::unordered_map;
@@ -32,7 +29,9 @@ std::size_t Graph::addVertex(string nodeName)
 
 	name2Index[nodeName] = (vertex)adjacencyLists.size();
 
-	adjacencyLists.push_back(std::unordered_set<vertex>());
+	pushVertex();
+
+	index2Name.back() = nodeName;
 
 	return adjacencyLists.size() - 1;
 }
@@ -52,78 +51,83 @@ bool Graph::addEdge(vertex vertexA, vertex vertexB)
 		return false;
 	} // end if
 	else
-	{ // add edges for both direction
-		adjacencyLists[vertexA].insert(vertexB);
-		adjacencyLists[vertexB].insert(vertexA);
-
-		edge e = 0;
-
-		auto a_less_b = (vertexA < vertexB);
-		e = a_less_b ? new_edge(vertexA, vertexB) : new_edge(vertexB, vertexA);
-		edges[e] = directed ? (a_less_b ? DIR_U_T_V : DIR_V_T_U) : UNDIR_U_V;
+	{
+		connect(vertexA, vertexB);
 
 		return true;
 	} // end else
 } // end method addEdge
 
 
-// parses a data file into an adjacency list representing the graph
-void Graph::parse(const string& filename) 
+/**
+	* Connect two vertices, from vertexA to vertexB if this Graph is directed.
+	* The underlying undirected edge is always added in both adjacency lists.
+	* Directions accumulate, so a pair given both ways is connected in both
+	* directions rather than the last one overwriting the first.
+ */
+void Graph::connect(vertex vertexA, vertex vertexB)
 {
-	std::vector<string> lines;
-	string currentline, from, to;
-	std::stringstream linesplits;
-	std::ifstream in(filename, std::ios::in);
-	
-	// allocate enough memory for all edges
-	lines.reserve(std::count(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(), '\n'));
-	in.seekg(std::ios::beg);
-
-	if (!in.is_open() || in.bad()) 
+	const bool newPair = adjacencyLists[vertexA].insert(vertexB).second;
+	adjacencyLists[vertexB].insert(vertexA);
+
+	if (newPair)
 	{
-		throw std::invalid_argument("Cannot find an input file");
+		edgeCount++;
 	} // end if
-	
-	// read in the entire graph
-	while (in) 
-	{
-		getline(in, currentline);
-		if (currentline.size() > 0) 
-		{
-			lines.push_back(currentline);
-		}
-	}
 
-	in.close();
+	if (!directed)
+	{
+		return;
+	} // end if
 
-	// randomly parse input to avoid data bias
-	std::shuffle(lines.begin(), lines.end(), RNG_provider());
+	auto& out = outAdjacencyLists[vertexA];
 
-	for (auto& line : lines) 
+	// duplicate lines must not duplicate neighbors, only a pair
+	// that is already connected can already have this direction
+	if (newPair || std::find(out.begin(), out.end(), vertexB) == out.end())
 	{
-		vertex fromIndex, toIndex;
-		edge e = 0;
+		out.push_back(vertexB);
+		inAdjacencyLists[vertexB].push_back(vertexA);
+	} // end if
+} // end method connect
+
+
+// parses a data file into an adjacency list representing the graph
+void Graph::parse(const string& filename, const ParseOptions& options) 
+{
+	assign(read_edge_list(filename, directed, options));
+} // end method parse
 
-		linesplits << line;
-		linesplits >> from >> to;
-		linesplits.clear();
-		linesplits.str("");
 
-		fromIndex = getOrCreateIndex(from, name2Index);
-		toIndex = getOrCreateIndex(to, name2Index);
+// fills an empty Graph from an edge list, vertices keep their numbers and
+// the edge list decides the direction, graph6 family files carry their own
+void Graph::assign(const EdgeList& edgeList)
+{
+	directed = edgeList.m_b_directed;
 
-		// don't add self edges
-		if (fromIndex != toIndex)
-		{
-			adjacencyLists[fromIndex].insert(toIndex);
-			adjacencyLists[toIndex].insert(fromIndex);
+	addVertices(edgeList.mu_li_vertices);
+
+	// graph6 family files leave their vertices unnamed
+	if (false == edgeList.m_vect_names.empty() || false == edgeList.m_vect_ids.empty())
+	{
+		index2Name = vertex_names(edgeList);
+	} // end if
+
+	name2Index.reserve(index2Name.size());
 
-			auto a_less_b = (fromIndex < toIndex);
-			e = a_less_b ? new_edge(fromIndex, toIndex) : new_edge(toIndex, fromIndex);
-			edges[e] = directed ? (a_less_b ? DIR_U_T_V : DIR_V_T_U) : UNDIR_U_V;
+	for (std::size_t v = 0; v < index2Name.size(); v++)
+	{
+		if (false == index2Name[v].empty())
+		{
+			name2Index[index2Name[v]] = static_cast<vertex>(v);
 		} // end if
-	} // end for
-} // end method parse
+	} // end for v
+
+	for (const auto& e : edgeList.m_vect_edges)
+	{
+		connect(e.first, e.second);
+	} // end for e
+} // end method assign
 
 
 // get index of a node given the node's name
@@ -133,7 +137,8 @@ vertex Graph::getOrCreateIndex(const string& nodeName, unordered_map<string, ver
 	if (nameToIndex.count(nodeName) == 0) 
 	{ // if the key does not exists      
 		nameToIndex[nodeName] = static_cast<vertex>(adjacencyLists.size());
-		adjacencyLists.push_back(std::unordered_set<vertex>());
+		pushVertex();
+		index2Name.back() = nodeName;
 	}
 
 	return nameToIndex[nodeName];
@@ -149,32 +154,28 @@ std::ostream& operator<< (std::ostream& out, const Graph& graph)
 	}
 
 	out << std::endl << "Edges: " << std::endl;
-	for (auto ed : graph.edges)
+	for (vertex u = 0; u < graph.adjacencyLists.size(); u++)
 	{
-		edge code = ed.first;
-		edgetype type = ed.second;
-		vertex u = edge_get_u(code);
-		vertex v = edge_get_v(code);
-		out << "<";
+		if (graph.directed)
+		{
+			for (auto v : graph.outAdjacencyLists[u])
+			{
+				out << "<" << u << "->" << v << "> ";
+			}
+
+			continue;
+		}
 
-		switch (type)
+		for (auto v : graph.adjacencyLists[u])
 		{
-		case DIR_U_T_V:
-			out << u << "->" << v;
-			break;
-		case DIR_V_T_U:
-			out << v << "->" << u;
-			break;
-		case UNDIR_U_V:
-			out << u << "--" << v;
-			break;
-		default:
-			throw std::invalid_argument("Invalid edge type!");
+			if (u < v)
+			{
+				out << "<" << u << "--" << v << "> ";
+			}
 		}
-		out << "> ";
 	}
 
-	out << std::endl << (graph.directed ? "Directed" : "Undirected") << " Graph, |V| = " << graph.adjacencyLists.size() << ": |E| = " << graph.edges.size() << std::endl;
+	out << std::endl << (graph.directed ? "Directed" : "Undirected") << " Graph, |V| = " << graph.adjacencyLists.size() << ": |E| = " << graph.edgeCount << std::endl;
 
 	return out;
 }
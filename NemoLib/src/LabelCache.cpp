@@ -0,0 +1,207 @@
+#include <algorithm>   // sort
+#include <cstdint>     // uint64_t
+#include <cstdio>      // FILE, fopen, fwrite, fclose, rename, remove
+#include <cerrno>      // errno, ENOENT
+#include <cstring>     // memcpy, strerror
+#include <stdexcept>   // runtime_error
+
+#include <fcntl.h>     // open, O_RDONLY
+#include <unistd.h>    // close, getpid
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <sys/file.h>  // flock
+
+#include "LabelCache.hpp"
+
+
+namespace
+{
+    //! first word of a label cache file, also marks the format version
+    constexpr std::uint64_t ku_CACHE_MAGIC = 0x3130484341434C4Eull; // "NLCACH01"
+
+    //! magic word and entry count
+    constexpr std::size_t ku_li_HEADER_SIZE = 2 * sizeof(std::uint64_t);
+    //! raw and cannonical code
+    constexpr std::size_t ku_li_ENTRY_SIZE = 2 * sizeof(std::uint64_t);
+
+
+    /** @brief Holds the advisory lock of a cache file while in scope.
+      * @remark The cache file itself is replaced by every save, so the lock
+      *         is taken on a companion file that stays put.
+      */
+    class SaveLock
+    {
+    public:
+        explicit SaveLock(const std::string& kr_str_PATH_)
+        {
+            const std::string kr_str_lock_path = kr_str_PATH_ + ".lock";
+
+            m_fd = open(kr_str_lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+
+            if (-1 == m_fd)
+            {
+                throw std::runtime_error("Can't open lock file '" + kr_str_lock_path + "': " + std::strerror(errno));
+            } // end if
+
+            while (-1 == flock(m_fd, LOCK_EX))
+            {
+                if (EINTR != errno)
+                {
+                    close(m_fd);
+                    throw std::runtime_error("Can't lock '" + kr_str_lock_path + "': " + std::strerror(errno));
+                } // end if
+            } // end while
+        } // end Constructor
+
+        SaveLock(const SaveLock&) = delete;
+        SaveLock& operator=(const SaveLock&) = delete;
+
+        ~SaveLock(void)
+        {
+            // closing the descriptor releases the lock
+            close(m_fd);
+        } // end Destructor
+
+    private:
+        //! the open lock file
+        int m_fd;
+    }; // end class SaveLock
+} // end namespace
+
+
+std::vector<std::pair<MotifCode, MotifCode>> LabelCache::entries(void) const
+{
+    std::vector<std::pair<MotifCode, MotifCode>> vect_entries;
+
+    for (const Shard& kr_shard : m_arr_shards)
+    {
+        std::shared_lock guard(kr_shard.m_mtx);
+        vect_entries.insert(vect_entries.end(), kr_shard.m_umap_labels.begin(), kr_shard.m_umap_labels.end());
+    } // end for kr_shard
+
+    std::sort(vect_entries.begin(), vect_entries.end());
+
+    return vect_entries;
+} // end method entries
+
+
+bool LabelCache::load(const std::string& kr_str_PATH_, std::size_t* p_skipped_)
+{
+    const int k_fd = open(kr_str_PATH_.c_str(), O_RDONLY);
+
+    if (-1 == k_fd)
+    {
+        if (ENOENT == errno)
+        {
+            return false;
+        } // end if
+
+        throw std::runtime_error("Can't open label cache '" + kr_str_PATH_ + "': " + std::strerror(errno));
+    } // end if
+
+    struct stat file_stat;
+
+    if (-1 == fstat(k_fd, &file_stat))
+    {
+        close(k_fd);
+        throw std::runtime_error("Can't stat label cache '" + kr_str_PATH_ + "'");
+    } // end if
+
+    const std::size_t ku_li_size = static_cast<std::size_t>(file_stat.st_size);
+
+    if (ku_li_size < ku_li_HEADER_SIZE)
+    {
+        close(k_fd);
+        throw std::runtime_error("'" + kr_str_PATH_ + "' is not a label cache");
+    } // end if
+
+    void* p_map = mmap(nullptr, ku_li_size, PROT_READ, MAP_PRIVATE, k_fd, 0);
+
+    // the mapping stays valid once the descriptor is closed
+    close(k_fd);
+
+    if (MAP_FAILED == p_map)
+    {
+        throw std::runtime_error("Can't map label cache '" + kr_str_PATH_ + "'");
+    } // end if
+
+    const unsigned char* p_bytes = static_cast<const unsigned char*>(p_map);
+    std::uint64_t u_magic, u_count;
+
+    std::memcpy(&u_magic, p_bytes, sizeof(u_magic));
+    std::memcpy(&u_count, p_bytes + sizeof(u_magic), sizeof(u_count));
+
+    if (ku_CACHE_MAGIC != u_magic || u_count > (ku_li_size - ku_li_HEADER_SIZE) / ku_li_ENTRY_SIZE)
+    {
+        munmap(p_map, ku_li_size);
+        throw std::runtime_error("'" + kr_str_PATH_ + "' is not a label cache or is truncated");
+    } // end if
+
+    const unsigned char* p_entry = p_bytes + ku_li_HEADER_SIZE;
+    std::size_t u_li_skipped{0};
+
+    for (std::uint64_t i{0}; i < u_count; i++, p_entry += ku_li_ENTRY_SIZE)
+    {
+        MotifCode raw, cannonical;
+
+        std::memcpy(&raw, p_entry, sizeof(raw));
+        std::memcpy(&cannonical, p_entry + sizeof(raw), sizeof(cannonical));
+
+        // a label never changes the size or the directedness
+        if (Motif_Code::order(raw) != Motif_Code::order(cannonical) 
+            || Motif_Code::is_directed(raw) != Motif_Code::is_directed(cannonical))
+        {
+            u_li_skipped++;
+            continue;
+        } // end if
+
+        insert(raw, cannonical);
+    } // end for i
+
+    munmap(p_map, ku_li_size);
+
+    if (nullptr != p_skipped_)
+    {
+        *p_skipped_ = u_li_skipped;
+    } // end if
+
+    return true;
+} // end method load
+
+
+void LabelCache::save(const std::string& kr_str_PATH_)
+{
+    // another run may have saved since this one loaded, the lock keeps
+    // it from saving again until this merge has been renamed into place
+    const SaveLock k_lock(kr_str_PATH_);
+
+    load(kr_str_PATH_);
+
+    const std::vector<std::pair<MotifCode, MotifCode>> kr_vect_entries = entries();
+    const std::string kr_str_tmp_path = kr_str_PATH_ + "." + std::to_string(getpid()) + ".tmp";
+
+    FILE* p_file = std::fopen(kr_str_tmp_path.c_str(), "wb");
+
+    if (nullptr == p_file)
+    {
+        throw std::runtime_error("Can't write label cache '" + kr_str_tmp_path + "': " + std::strerror(errno));
+    } // end if
+
+    const std::uint64_t ku_count = kr_vect_entries.size();
+    bool b_ok = (1 == std::fwrite(&ku_CACHE_MAGIC, sizeof(ku_CACHE_MAGIC), 1, p_file))
+             && (1 == std::fwrite(&ku_count, sizeof(ku_count), 1, p_file));
+
+    for (const auto& kr_entry : kr_vect_entries)
+    {
+        const std::uint64_t ku_pair[2] = {kr_entry.first, kr_entry.second};
+        b_ok = b_ok && (1 == std::fwrite(ku_pair, sizeof(ku_pair), 1, p_file));
+    } // end for kr_entry
+
+    b_ok = (0 == std::fclose(p_file)) && b_ok;
+
+    if (false == b_ok || 0 != std::rename(kr_str_tmp_path.c_str(), kr_str_PATH_.c_str()))
+    {
+        std::remove(kr_str_tmp_path.c_str());
+        throw std::runtime_error("Can't write label cache '" + kr_str_PATH_ + "'");
+    } // end if
+} // end method save
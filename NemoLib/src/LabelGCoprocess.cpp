@@ -0,0 +1,137 @@
+#include <stdexcept>     // runtime_error
+
+#include "LabelGCoprocess.hpp"
+
+#ifndef _WIN32
+
+#include <csignal>       // signal, SIGPIPE, SIG_IGN
+#include <spawn.h>       // posix_spawn, posix_spawn_file_actions_*
+#include <unistd.h>      // pipe2, close
+#include <fcntl.h>       // O_CLOEXEC
+#include <sys/types.h>   // pid_t
+#include <sys/wait.h>    // waitpid
+
+extern char** environ;
+
+
+LabelGCoprocess::~LabelGCoprocess(void) noexcept
+{
+    if (nullptr != m_p_to_child)
+    {
+        fclose(m_p_to_child);
+    } // end if
+
+    if (nullptr != m_p_from_child)
+    {
+        fclose(m_p_from_child);
+    } // end if
+
+    if (0 < ml_pid_child)
+    {
+        waitpid(static_cast<pid_t>(ml_pid_child), nullptr, 0);
+    } // end if
+} // end Destructor
+
+
+void LabelGCoprocess::spawn(const std::string& kr_str_LABELG_PATH_)
+{
+    // a write to a labelg that died must fail with EPIPE so label()
+    // returns false, instead of SIGPIPE killing the whole process
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int p_i_to_child[2], p_i_from_child[2];
+
+    // other coprocesses must not inherit these pipes, or labelg would
+    // never see EOF on its stdin when this object closes its end
+    if (0 != pipe2(p_i_to_child, O_CLOEXEC))
+    {
+        throw std::runtime_error("Could not create pipe for labelg");
+    } // end if
+
+    if (0 != pipe2(p_i_from_child, O_CLOEXEC))
+    {
+        close(p_i_to_child[0]);
+        close(p_i_to_child[1]);
+        throw std::runtime_error("Could not create pipe for labelg");
+    } // end if
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, p_i_to_child[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, p_i_from_child[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, p_i_to_child[1]);
+    posix_spawn_file_actions_addclose(&actions, p_i_from_child[0]);
+
+    std::string str_path{kr_str_LABELG_PATH_};
+    char* p_argv[] = {&str_path[0], nullptr};
+
+    pid_t pid_child = 0;
+    int i_result = posix_spawn(&pid_child, str_path.c_str(), &actions, nullptr, p_argv, environ);
+
+    posix_spawn_file_actions_destroy(&actions);
+
+    // the child's ends of the pipes are no longer needed here
+    close(p_i_to_child[0]);
+    close(p_i_from_child[1]);
+
+    if (0 != i_result)
+    {
+        close(p_i_to_child[1]);
+        close(p_i_from_child[0]);
+        throw std::runtime_error("Could not start labelg at '" + kr_str_LABELG_PATH_ + "'");
+    } // end if
+
+    ml_pid_child = static_cast<long>(pid_child);
+    m_p_to_child = fdopen(p_i_to_child[1], "w");
+    m_p_from_child = fdopen(p_i_from_child[0], "r");
+} // end method spawn
+
+
+bool LabelGCoprocess::label(const std::string& kr_str_LABEL_, std::string& str_cannonical_label)
+{
+    // size of the buffer used to communicate with labelg
+    constexpr std::size_t ku_li_buffer_size = 512;
+
+    char p_buffer[ku_li_buffer_size];
+
+    if (EOF == fputs(kr_str_LABEL_.c_str(), m_p_to_child) || EOF == fputc('\n', m_p_to_child) || 0 != fflush(m_p_to_child))
+    {
+        return false;
+    } // end if
+
+    str_cannonical_label.clear();
+
+    // labels longer than the buffer arrive in several pieces
+    while (nullptr != fgets(p_buffer, sizeof(p_buffer), m_p_from_child))
+    {
+        str_cannonical_label += p_buffer;
+
+        if ('\n' == str_cannonical_label.back())
+        {
+            str_cannonical_label.pop_back();
+            return true;
+        } // end if
+    } // end while
+
+    return false;
+} // end method label
+
+#else // _WIN32
+
+LabelGCoprocess::~LabelGCoprocess(void) noexcept
+{
+} // end Destructor
+
+
+void LabelGCoprocess::spawn(const std::string& kr_str_LABELG_PATH_)
+{
+    throw std::runtime_error("labelg coprocesses are not supported on this platform, can't start '" + kr_str_LABELG_PATH_ + "'");
+} // end method spawn
+
+
+bool LabelGCoprocess::label(const std::string&, std::string&)
+{
+    return false;
+} // end method label
+
+#endif // !_WIN32
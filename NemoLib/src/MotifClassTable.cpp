@@ -0,0 +1,108 @@
+#include <algorithm> // next_permutation
+#include <numeric>   // iota
+#include <limits>    // numeric_limits
+
+#include "MotifClassTable.hpp"
+
+
+const MotifClassTable* MotifClassTable::get(std::size_t u_li_k_, bool b_directed_)
+{
+    // function-local statics are built once and thread-safe,
+    // so only the sizes actually enumerated are ever built
+    if (true == b_directed_)
+    {
+        switch (u_li_k_)
+        {
+            case 2: { static const MotifClassTable s_table(2, true); return &s_table; }
+            case 3: { static const MotifClassTable s_table(3, true); return &s_table; }
+            case 4: { static const MotifClassTable s_table(4, true); return &s_table; }
+            default: return nullptr;
+        } // end switch
+    } // end if
+
+    switch (u_li_k_)
+    {
+        case 2: { static const MotifClassTable s_table(2, false); return &s_table; }
+        case 3: { static const MotifClassTable s_table(3, false); return &s_table; }
+        case 4: { static const MotifClassTable s_table(4, false); return &s_table; }
+        case 5: { static const MotifClassTable s_table(5, false); return &s_table; }
+        case 6: { static const MotifClassTable s_table(6, false); return &s_table; }
+        default: return nullptr;
+    } // end switch
+} // end method get
+
+
+MotifClassTable::MotifClassTable(std::size_t u_li_k_, bool b_directed_)
+ : mu_li_k(u_li_k_), m_b_directed(b_directed_)
+{
+    //! mask bit of each (row, column), used to permute masks
+    std::vector<std::vector<std::size_t>> vect_bit_of(mu_li_k, std::vector<std::size_t>(mu_li_k, 0));
+
+    // same order as the adjacency of a MotifCode, the upper
+    // triangle by column or all off-diagonal entries by row
+    for (std::size_t a{0}; a < mu_li_k; a++)
+    {
+        for (std::size_t b{0}; b < mu_li_k; b++)
+        {
+            const std::size_t i = m_b_directed ? a : b;
+            const std::size_t j = m_b_directed ? b : a;
+
+            if (i != j && (m_b_directed || i < j))
+            {
+                vect_bit_of[i][j] = m_vect_pairs.size();
+                m_vect_pairs.emplace_back(static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(j));
+            } // end if
+        } // end for b
+    } // end for a
+
+    //! marks bitmasks that have not been classified yet
+    constexpr std::uint16_t ku_UNCLASSIFIED = std::numeric_limits<std::uint16_t>::max();
+    const mask_t k_n_masks = mask_t{1} << m_vect_pairs.size();
+
+    m_vect_class.assign(k_n_masks, ku_UNCLASSIFIED);
+
+    std::vector<std::size_t> vect_perm(mu_li_k);
+
+    // masks are visited in increasing order, so the first
+    // mask of a class is the smallest one and its representative
+    for (mask_t mask{0}; mask < k_n_masks; mask++)
+    {
+        if (ku_UNCLASSIFIED != m_vect_class[mask])
+        {
+            continue;
+        } // end if
+
+        const std::uint16_t ku_class = static_cast<std::uint16_t>(m_vect_representatives.size());
+        m_vect_representatives.push_back(mask);
+
+        std::iota(vect_perm.begin(), vect_perm.end(), 0);
+
+        // every relabeling of the vertices is in the same class
+        do
+        {
+            mask_t permuted{0};
+
+            for (std::size_t p{0}; p < m_vect_pairs.size(); p++)
+            {
+                if (0 != (mask & (mask_t{1} << p)))
+                {
+                    std::size_t u = vect_perm[m_vect_pairs[p].first];
+                    std::size_t v = vect_perm[m_vect_pairs[p].second];
+
+                    if (false == m_b_directed && u > v)
+                    {
+                        std::swap(u, v);
+                    } // end if
+
+                    permuted |= mask_t{1} << vect_bit_of[u][v];
+                } // end if
+            } // end for p
+
+            m_vect_class[permuted] = ku_class;
+        } while (std::next_permutation(vect_perm.begin(), vect_perm.end()));
+    } // end for mask
+
+    m_vect_labels.resize(m_vect_representatives.size());
+    m_p_once_labeled = std::make_unique<std::once_flag[]>(m_vect_representatives.size());
+} // end Constructor
+
@@ -0,0 +1,152 @@
+/*
+ * File:   NautyCanon.cpp
+ *
+ * In-process replacement for the labelg program. Mirrors what labelg
+ * does for a single graph (fcanonise without invariants) so that labels
+ * are identical to the ones obtained through the external program.
+ */
+
+#include <vector>          // vector
+#include <string>          // string
+#include <mutex>           // mutex, lock_guard
+
+#include "NautyCanon.hpp"
+
+#include "gtools.h"        // stringtograph, graphsize, ntog6, ntod6, densenauty
+
+
+namespace Nauty_Canon
+{
+#ifndef USE_TLS
+    //! nauty is not re-entrant unless it was built with thread local storage
+    //! (nautyT, see the nauty_tls option), otherwise every call is serialized
+    static std::mutex s_mtx_nauty;
+#endif // !USE_TLS
+
+
+    /** @brief Relabels a graph canonically the way labelg does.
+      * @param p_graph_ The graph, m setwords per vertex
+      * @param p_canon_ Receives the cannonical graph, as large as the graph
+      */
+    static void canonise(graph* p_graph_, const int m, const int n, const bool kb_DIGRAPH_, graph* p_canon_)
+    {
+        std::vector<int> vect_lab(n), vect_ptn(n), vect_orbits(n);
+
+        // labelg runs without a vertex invariant, so the plain graph options
+        // are used for digraphs as well (DEFAULTOPTIONS_DIGRAPH adds one)
+        DEFAULTOPTIONS_GRAPH(options);
+        statsblk stats;
+
+        options.getcanon = TRUE;
+        options.digraph = kb_DIGRAPH_ ? TRUE : FALSE;
+
+#ifndef USE_TLS
+        std::lock_guard<std::mutex> guard(s_mtx_nauty);
+#endif // !USE_TLS
+
+        densenauty(p_graph_, vect_lab.data(), vect_ptn.data(), vect_orbits.data(), &options, &stats, m, n, p_canon_);
+    } // end method canonise
+
+
+    std::string canonical_label(const std::string& kr_str_LABEL_)
+    {
+        // nauty's parsers want a mutable, newline terminated line
+        std::string str_line{kr_str_LABEL_ + "\n"};
+        char* p_line = &str_line[0];
+
+        const bool k_b_DIGRAPH = (str_line[0] == '&');
+        const int n = graphsize(p_line);
+        const int m = SETWORDSNEEDED(n);
+
+        nauty_check(WORDSIZE, m, n, NAUTYVERSIONID);
+
+        std::vector<graph> vect_graph(static_cast<std::size_t>(m) * static_cast<std::size_t>(n));
+        std::vector<graph> vect_canon(vect_graph.size());
+
+        stringtograph(p_line, vect_graph.data(), m);
+
+        canonise(vect_graph.data(), m, n, k_b_DIGRAPH, vect_canon.data());
+
+        std::string str_canon{k_b_DIGRAPH ? ntod6(vect_canon.data(), m, n) : ntog6(vect_canon.data(), m, n)};
+
+        // ntog6/ntod6 terminate the line like labelg does
+        if (false == str_canon.empty() && '\n' == str_canon.back())
+        {
+            str_canon.pop_back();
+        } // end if
+
+        return str_canon;
+    } // end method canonical_label
+
+
+    MotifCode canonical_code(const MotifCode k_RAW_)
+    {
+        const int n = static_cast<int>(Motif_Code::order(k_RAW_));
+        const bool kb_DIGRAPH = Motif_Code::is_directed(k_RAW_);
+
+        // every row of a motif fits a single setword
+        static_assert(Motif_Code::ku_li_MAX_UNDIRECTED <= WORDSIZE, "a motif must fit one setword per vertex");
+        const int m = 1;
+
+        nauty_check(WORDSIZE, m, n, NAUTYVERSIONID);
+
+        graph arr_graph[Motif_Code::ku_li_MAX_UNDIRECTED] = {};
+        graph arr_canon[Motif_Code::ku_li_MAX_UNDIRECTED] = {};
+
+        // the bits follow from_matrix, the upper triangle by column or
+        // the rows without their diagonal entry
+        unsigned u_bit{0};
+
+        for (int a{0}; a < n; a++)
+        {
+            for (int b{0}; b < n; b++)
+            {
+                const int i = kb_DIGRAPH ? a : b;
+                const int j = kb_DIGRAPH ? b : a;
+
+                if (i == j || (false == kb_DIGRAPH && i > j))
+                {
+                    continue;
+                } // end if
+
+                if (0 != ((k_RAW_ >> u_bit++) & 1))
+                {
+                    ADDELEMENT(GRAPHROW(arr_graph, i, m), j);
+
+                    if (false == kb_DIGRAPH)
+                    {
+                        ADDELEMENT(GRAPHROW(arr_graph, j, m), i);
+                    } // end if
+                } // end if
+            } // end for b
+        } // end for a
+
+        canonise(arr_graph, m, n, kb_DIGRAPH, arr_canon);
+
+        MotifCode code = Motif_Code::empty(static_cast<std::size_t>(n), kb_DIGRAPH);
+        u_bit = 0;
+
+        for (int a{0}; a < n; a++)
+        {
+            for (int b{0}; b < n; b++)
+            {
+                const int i = kb_DIGRAPH ? a : b;
+                const int j = kb_DIGRAPH ? b : a;
+
+                if (i == j || (false == kb_DIGRAPH && i > j))
+                {
+                    continue;
+                } // end if
+
+                if (ISELEMENT(GRAPHROW(arr_canon, i, m), j))
+                {
+                    code |= MotifCode{1} << u_bit;
+                } // end if
+
+                u_bit++;
+            } // end for b
+        } // end for a
+
+        return code;
+    } // end method canonical_code
+} // end namespace Nauty_Canon
@@ -13,100 +13,301 @@
 
 #include <cassert>
 #include <vector>
-#include <cmath>
 #include <cstring>
 #include <string>
+#include <stdexcept>
 
 #include "loguru.hpp"
 
 #include "Global.hpp"
 #include "NautyLink.hpp"
+#include "LabelCache.hpp"
 
 
-std::string NautyLink::nautylabel_helper(Subgraph& subgraph)
+MotifCode NautyLink::nautylabel_helper(Subgraph& subgraph)
 {
     DLOG_F(INFO, "In nautylabel helper ...");
 
-	// get the node(index) list from subgraph
-	std::size_t subsize = subgraph.getSize();
-	std::size_t n_chars{0};
-	std::vector<char> vect_label;
-
-    std::vector<std::vector<bool>> vect_adj_matrix{subsize, std::vector<bool>(subsize, false)};
+	// get adjacency for R(x)
+	const MotifCode k_raw_code = raw_code(subgraph);
 
-	// undirected only needs half the matrix
-	if (directed == false)
+	// small motifs are classified by a table lookup, the labeler
+	// only runs once per class to name it
+	if (nullptr != m_p_class_table)
 	{
-		n_chars = subsize * (subsize - 1) / 2;
+		return m_p_class_table->label(k_raw_code,
+			[this](const MotifCode k_REPRESENTATIVE_)
+			{
+				return cannonical_code(k_REPRESENTATIVE_);
+			} // end lambda
+		);
 	} // end if
-	else
+
+	return cannonical_code(k_raw_code);
+} // end method nautylabel_helper
+
+
+MotifCode NautyLink::raw_code(const Subgraph& subgraph)
+{
+	return raw_code(subgraph.data(), subgraph.getSize());
+} // end method raw_code
+
+
+MotifCode NautyLink::raw_code(const InlineSubgraph& subgraph)
+{
+	return raw_code(subgraph.data(), subgraph.getSize());
+} // end method raw_code
+
+
+MotifCode NautyLink::raw_code(const vertex* graph_nodes, const std::size_t subsize)
+{
+	MotifCode code = Motif_Code::empty(subsize, directed);
+
+	// reported subgraphs are numbered as in the Graph
+	vertex nodes[MAXN];
+
+	for (std::size_t i{0}; i < subsize; i++)
 	{
-		n_chars = subsize * subsize;
-	} // end else
+		nodes[i] = m_p_graph->renumbered(graph_nodes[i]);
+	} // end for i
 
-	// pad with 0s to length 6k + 0 
-	n_chars += n_chars % 6 == 0 ? 0 : 6 - (n_chars % 6);
+	// the sizes ESU has engines for get the unrolled lookups
+	switch (subsize)
+	{
+		case 3:  return raw_code<3>(nodes);
+		case 4:  return raw_code<4>(nodes);
+		case 5:  return raw_code<5>(nodes);
+		case 6:  return raw_code<6>(nodes);
+		case 7:  return raw_code<7>(nodes);
+		case 8:  return raw_code<8>(nodes);
+		case 9:  return raw_code<9>(nodes);
+		case 10: return raw_code<10>(nodes);
+		default: break;
+	} // end switch
 
-	// initialize all characters to 63
-	vect_label.resize((n_chars / 6) + 1, static_cast<char>(63));
+	if (false == directed)
+	{
+		// the upper triangle by column is the graph6 bit order, so
+		// every pair is looked up once and lands on the next bit
+		unsigned u_bit{0};
 
-	// set N(n)
-	vect_label[0] = static_cast<char>(63 + subsize);
+		for (std::size_t j{1}; j < subsize; j++)
+		{
+			const vertex vc = nodes[j];
 
-	// get adjacency for R(x)
-	getAdjacency(subgraph, vect_adj_matrix);
+			for (std::size_t i{0}; i < j; i++, u_bit++)
+			{
+				if (true == m_p_graph->hasEdge(nodes[i], vc))
+				{
+					code |= MotifCode{1} << u_bit;
+				} // end if
+			} // end for i
+		} // end for j
 
-	// index currently being processed (0 is N(n) so start at 1)
-	std::size_t current_index{1};
-	// each 6 bits belong to a character
-	int counter = 0;
+		return code;
+	} // end if
 
-	for (std::size_t j{0}; j < subsize; j++)
+	// a single lookup per pair gives both directions
+	const std::size_t row = subsize - 1;
+
+	for (std::size_t i{0}; i < subsize; i++)
 	{
-		for (std::size_t i{0}; (directed ? i < subsize : i < j); i++)
+		const vertex uc = nodes[i];
+
+		for (std::size_t j{i + 1}; j < subsize; j++)
 		{
-			if (true == vect_adj_matrix[i][j])
+			// edge types are relative to the first vertex
+			const edgetype et = m_p_graph->edgeType(uc, nodes[j]);
+
+			if (0 != (et & DIR_U_T_V))
 			{
-				vect_label[current_index] += static_cast<char>(static_cast<int>(std::pow(2, 5 - counter)));
-			}
-			counter += 1;
+				code |= MotifCode{1} << (i * row + j - 1);
+			} // end if
 
-			if (counter == 6)
+			if (0 != (et & DIR_V_T_U))
 			{
-				current_index += 1;
-				counter = 0;
+				code |= MotifCode{1} << (j * row + i);
 			} // end if
 		} // end for j
 	} // end for i
-	
-	std::string my_label(vect_label.begin(), vect_label.end());
 
-	auto callback = std::packaged_task<std::string(std::string)>(
-		[](std::string s)
+	return code;
+} // end method raw_code
+
+
+MotifCode NautyLink::cannonical_code(const MotifCode k_raw_code)
+{
+	MotifCode cannonical_code;
+
+	// motif classes repeat across graphs, so nearly every code is
+	// already known and the worker round trip can be skipped
+	if (true == LabelCache::instance().find(k_raw_code, cannonical_code))
+	{
+		return cannonical_code;
+	} // end if
+
+	#if _USE_NAUTY
+		if (true == m_b_in_process)
 		{
-			return s;
+			// straight from the code to nauty and back, no text or queue
+			cannonical_code = Nauty_Canon::canonical_code(k_raw_code);
+
+			LabelCache::instance().insert(k_raw_code, cannonical_code);
+
+			return cannonical_code;
+		} // end if
+	#endif
+
+	std::vector<std::string> vect_labels = request_labels({Motif_Code::to_g6(k_raw_code)});
+
+	cannonical_code = answer_code(k_raw_code, vect_labels.front());
+
+	// memoize for every labeler in the process
+	LabelCache::instance().insert(k_raw_code, cannonical_code);
+
+	return cannonical_code;
+} // end method cannonical_code
+
+
+MotifCode NautyLink::answer_code(const MotifCode raw, const std::string& label)
+{
+	const MotifCode code = Motif_Code::from_g6(label);
+
+	// a labelg that answers digraphs in graph6 drops the arc directions,
+	// which would merge classes that aren't isomorphic
+	if (Motif_Code::is_directed(code) != Motif_Code::is_directed(raw) || Motif_Code::order(code) != Motif_Code::order(raw))
+	{
+		throw std::runtime_error("The labeler answered '" + Motif_Code::to_g6(raw) + "' with '" + label + "', "
+		                         "a directed graph must be answered in digraph6, rebuild labelg from nauty26r12/labelg.c");
+	} // end if
+
+	return code;
+} // end method answer_code
+
+
+void NautyLink::nautylabel_batch(const std::vector<Subgraph>& subgraphs, std::vector<MotifCode>& labels)
+{
+	std::vector<MotifCode> vect_raw_codes;
+	vect_raw_codes.reserve(subgraphs.size());
+
+	for (const Subgraph& subgraph : subgraphs)
+	{
+		vect_raw_codes.push_back(raw_code(subgraph));
+	} // end for subgraph
+
+	label_batch(vect_raw_codes, labels);
+} // end method nautylabel_batch
+
+
+void NautyLink::nautylabel_batch(const std::vector<InlineSubgraph>& subgraphs, std::vector<MotifCode>& labels)
+{
+	std::vector<MotifCode> vect_raw_codes;
+	vect_raw_codes.reserve(subgraphs.size());
+
+	for (const InlineSubgraph& subgraph : subgraphs)
+	{
+		vect_raw_codes.push_back(raw_code(subgraph));
+	} // end for subgraph
+
+	label_batch(vect_raw_codes, labels);
+} // end method nautylabel_batch
+
+
+void NautyLink::label_batch(const std::vector<MotifCode>& raw_codes, std::vector<MotifCode>& labels)
+{
+	labels.resize(raw_codes.size());
+
+	// subgraphs whose code has to be sent to the labeler
+	std::vector<std::size_t> vect_misses;
+
+	for (std::size_t i{0}; i < raw_codes.size(); i++)
+	{
+		if (nullptr != m_p_class_table)
+		{
+			labels[i] = m_p_class_table->label(raw_codes[i],
+				[this](const MotifCode k_REPRESENTATIVE_)
+				{
+					return cannonical_code(k_REPRESENTATIVE_);
+				} // end lambda
+			);
+		} // end if
+		else if (false == LabelCache::instance().find(raw_codes[i], labels[i]))
+		{
+			vect_misses.push_back(i);
+		} // end elif
+	} // end for i
+
+	if (true == vect_misses.empty())
+	{
+		return;
+	} // end if
+
+	// nauty labels on this thread, there is no round trip to save
+	if (true == m_b_in_process)
+	{
+		for (std::size_t i : vect_misses)
+		{
+			labels[i] = cannonical_code(raw_codes[i]);
+		} // end for i
+
+		return;
+	} // end if
+
+	// each distinct code is labeled once, however often it occurs
+	std::unordered_map<MotifCode, std::size_t> umap_slots;
+	std::vector<MotifCode> vect_distinct;
+	std::vector<std::string> vect_labels;
+
+	for (std::size_t i : vect_misses)
+	{
+		if (true == umap_slots.emplace(raw_codes[i], vect_distinct.size()).second)
+		{
+			vect_distinct.push_back(raw_codes[i]);
+			vect_labels.push_back(Motif_Code::to_g6(raw_codes[i]));
+		} // end if
+	} // end for i
+
+	vect_labels = request_labels(std::move(vect_labels));
+
+	std::vector<MotifCode> vect_cannonical(vect_distinct.size());
+
+	for (std::size_t s{0}; s < vect_distinct.size(); s++)
+	{
+		vect_cannonical[s] = answer_code(vect_distinct[s], vect_labels[s]);
+		LabelCache::instance().insert(vect_distinct[s], vect_cannonical[s]);
+	} // end for s
+
+	for (std::size_t i : vect_misses)
+	{
+		labels[i] = vect_cannonical[umap_slots[raw_codes[i]]];
+	} // end for i
+} // end method label_batch
+
+
+std::vector<std::string> NautyLink::request_labels(std::vector<std::string> vect_labels)
+{
+	auto callback = std::packaged_task<std::vector<std::string>(std::vector<std::string>)>(
+		[](std::vector<std::string> v)
+		{
+			return v;
 		} // end lambda
 	);// end callback
 
-    DLOG_F(DEBUG_LEVEL, "Getting ready to get the label for %s ...", my_label.c_str());
+    DLOG_F(DEBUG_LEVEL, "Getting ready to get %zu labels ...", vect_labels.size());
 
 	auto my_future = callback.get_future();
 
 	// we have to wrap the callback as it can't be copied
-	m_lgp_cannonical_labeler.add_job(my_label, [&](std::string s){callback(s);});
+	m_lgp_cannonical_labeler.add_jobs(std::move(vect_labels), [&](std::vector<std::string> v){callback(std::move(v));});
 
-    DLOG_F(DEBUG_LEVEL, "Waiting for label ...");
+    DLOG_F(DEBUG_LEVEL, "Waiting for labels ...");
 
 	my_future.wait();
 
     DLOG_F(DEBUG_LEVEL, "Labeling done, retrieving future ...");
 
-	std::string str_cannonical_lbl = my_future.get();
-
-    DLOG_F(DEBUG_LEVEL, "G6 label %s has cannonical label %s", my_label.c_str(), str_cannonical_lbl.c_str());
-
-	return str_cannonical_lbl;
-}
+	return my_future.get();
+} // end method request_labels
 
 void NautyLink::getAdjacency(Subgraph& subgraph, std::vector<std::vector<bool>>& matrix)
 {
@@ -119,18 +320,13 @@ void NautyLink::getAdjacency(Subgraph& subgraph, std::vector<std::vector<bool>>&
 		{
 			if (i != j)
 			{
-				vertex uc = subgraph.get(i);
-				vertex vc = subgraph.get(j);
-				edge e_check = edge_code(uc, vc);
-				//if there is an edge between nodes[i] and nodes[j], connect i and j 
-				if (edges.count(e_check) > 0)
+				vertex uc = m_p_graph->renumbered(subgraph.get(i));
+				vertex vc = m_p_graph->renumbered(subgraph.get(j));
+				//if there is an edge from nodes[i] to nodes[j], connect i and j 
+				if (0 != (m_p_graph->edgeType(uc, vc) & DIR_U_T_V))
 				{
-					edgetype ec = edges[e_check];
-					if (((uc < vc) && (ec == DIR_U_T_V)) || ((uc > vc) && (ec == DIR_V_T_U)) || ec == UNDIR_U_V)
-					{
-						matrix[i][j] = true;
-					} // end if
-				} // end if (edges.count(e_check) > 0)
+					matrix[i][j] = true;
+				} // end if
 			} // end if (i != j)
 		} // end for j
 	} // end for i
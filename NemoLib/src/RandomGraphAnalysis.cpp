@@ -42,13 +42,13 @@ using std::unordered_map;
  */
 
 
-unordered_map <std::string, vector<double>> RandomGraphAnalysis::analyze(Graph& targetGraph, int randomGraphCount, int subgraphSize, const vector<double>& probs, const std::string& labelg_path)
+unordered_map <MotifCode, vector<double>> RandomGraphAnalysis::analyze(Graph& targetGraph, int randomGraphCount, int subgraphSize, const vector<double>& probs, const LabelGOptions& labelg_options)
 {
 	// create the return map and fill it with the labels we found in the
 	// target graph, as those are the only labels about which we care
 	// TODO consider changing this, as it creates the precondition of
 	// executing the target graph analysis first
-	unordered_map<std::string, vector<double>> labelRelFreqsMap;
+	unordered_map<MotifCode, vector<double>> labelRelFreqsMap;
 	for (int i = 0; i < randomGraphCount; i++)
 	{
         LOG_F(INFO, "Analyzing random graph %i", i + 1);
@@ -58,13 +58,13 @@ unordered_map <std::string, vector<double>> RandomGraphAnalysis::analyze(Graph&
 
 		// enumerate random graphs
 		SubgraphCount subgraphCount;
-		RandESU::enumerate<SubgraphCount>(randomGraph, &subgraphCount, subgraphSize, probs, labelg_path);
-		unordered_map<std::string, double> curLabelRelFreqMap = std::move(subgraphCount.getRelativeFrequencies());
+		RandESU::enumerate<SubgraphCount>(randomGraph, &subgraphCount, subgraphSize, probs, labelg_options);
+		unordered_map<MotifCode, double> curLabelRelFreqMap = std::move(subgraphCount.getRelativeFrequencies());
 
 		// populate labelRelReqsMap with result
 		for (const auto& curLabelRelFreqPair : curLabelRelFreqMap)
 		{
-			std::string curLabel = curLabelRelFreqPair.first;
+			MotifCode curLabel = curLabelRelFreqPair.first;
 			double curFreq = curLabelRelFreqPair.second;
 			labelRelFreqsMap[curLabel].push_back(curFreq);
 		}
@@ -27,9 +27,65 @@ Graph RandomGraphGenerator::generate(const Graph& inputGraph)
 {
     DLOG_F(DEBUG_LEVEL, "In RandomGraphGenerator::generate ... ");
 
-	vector<int> degreeSeq = std::move(getDegreeSequenceVector(inputGraph));
+	// a directed graph keeps the in- and out-degree of every vertex
+	if (inputGraph.isDirected())
+	{
+		vector<int> outDegreeSeq(inputGraph.getSize()), inDegreeSeq(inputGraph.getSize());
+
+		for (vertex vert = 0; vert < inputGraph.getSize(); vert++)
+		{
+			outDegreeSeq[vert] = static_cast<int>(inputGraph.getOutAdjacencyList(vert).size());
+			inDegreeSeq[vert] = static_cast<int>(inputGraph.getInAdjacencyList(vert).size());
+		} // end for vertex
+
+		return generateDirected(outDegreeSeq, inDegreeSeq);
+	} // end if
+
+	return generateUndirected(getDegreeSequenceVector(inputGraph));
+} // end method generate
+
+
+/**
+ * Generates a random graph with the degree sequence of a CSR snapshot, which
+ * may have been mapped from a file. Vertices keep the numbering of the Graph
+ * the snapshot was taken of.
+ * @param inputGraph the snapshot from which to derive the degree sequence
+ * @return the random Graph
+ */
+Graph RandomGraphGenerator::generate(const CSRGraph& inputGraph)
+{
+    DLOG_F(DEBUG_LEVEL, "In RandomGraphGenerator::generate ... ");
+
+	vector<int> outDegreeSeq(inputGraph.getSize()), inDegreeSeq(inputGraph.getSize());
+
+	for (vertex vert = 0; vert < inputGraph.getSize(); vert++)
+	{
+		const vertex snapshotVert = inputGraph.renumbered(vert);
+
+		outDegreeSeq[vert] = static_cast<int>(inputGraph.outDegree(snapshotVert));
+		inDegreeSeq[vert] = static_cast<int>(inputGraph.inDegree(snapshotVert));
+	} // end for vertex
+
+	// undirected snapshots report the degree as both
+	if (inputGraph.isDirected())
+	{
+		return generateDirected(outDegreeSeq, inDegreeSeq);
+	} // end if
+
+	return generateUndirected(outDegreeSeq);
+} // end method generate
+
+
+/**
+ * Generates a random undirected graph by pairing the stubs of a degree
+ * sequence at random, dropping self-edges and collapsing repeated pairs.
+ * @param degreeSeq the degree of every vertex
+ * @return the random Graph
+ */
+Graph RandomGraphGenerator::generateUndirected(const vector<int>& degreeSeq)
+{
 	vector<vertex> vertexList;
-	Graph randomGraph(inputGraph.isDirected());
+	Graph randomGraph(false);
 
     DLOG_F(DEBUG_LEVEL, "Setup complete");
 
@@ -41,7 +97,7 @@ Graph RandomGraphGenerator::generate(const Graph& inputGraph)
 	// generate randomized list of vertices
 	// the vertexList is a set where each node is represented by a number
 	// of elements equal to that vertex's degree
-	for (vertex vert = 0; vert < inputGraph.getSize(); vert++)
+	for (vertex vert = 0; vert < degreeSeq.size(); vert++)
 	{
 		randomGraph.addVertex();
 		for (int degree = 0; degree < degreeSeq[vert]; degree++)
@@ -109,7 +165,7 @@ Graph RandomGraphGenerator::generate(const Graph& inputGraph)
     DLOG_F(DEBUG_LEVEL, "Random graph creation done, iterations of loop: %zu", count);
 
 	return randomGraph;
-} // end method generate
+} // end method generateUndirected
 
 
 Graph RandomGraphGenerator::generate(const Graph& inputGraph, const vector <int>& probs)
@@ -181,6 +237,41 @@ Graph RandomGraphGenerator::generate(const Graph& inputGraph, const vector <int>
 }
 
 
+/**
+ * Generates a random directed graph with the given in- and out-degree
+ * sequences by pairing every out-stub with a shuffled in-stub. Like the
+ * undirected generator, pairs that would form a self-edge are dropped and
+ * repeated pairs collapse into one edge.
+ * @param outDegreeSeq the out-degree of every vertex
+ * @param inDegreeSeq the in-degree of every vertex
+ * @return the random Graph
+ */
+Graph RandomGraphGenerator::generateDirected(const vector<int>& outDegreeSeq, const vector<int>& inDegreeSeq)
+{
+	Graph randomGraph(true);
+	vector<vertex> tails, heads;
+
+	for (vertex vert = 0; vert < outDegreeSeq.size(); vert++)
+	{
+		randomGraph.addVertex();
+		tails.insert(tails.end(), outDegreeSeq[vert], vert);
+		heads.insert(heads.end(), inDegreeSeq[vert], vert);
+	} // end for vertex
+
+	shuffle(heads.begin(), heads.end(), RNG_provider());
+
+	for (std::size_t i = 0; i < tails.size(); i++)
+	{
+		if (tails[i] != heads[i]) // avoid self-edge
+		{
+			randomGraph.addEdge(tails[i], heads[i]);
+		} // end if
+	} // end for i
+
+	return randomGraph;
+} // end method generateDirected
+
+
 /**
  * Generates a degree sequence vector for a given Graph
  * @param inputGraph the Graph from which to derive the degree sequence
@@ -13,6 +13,7 @@
 
 #include "SubgraphProfile.hpp"
 #include "Subgraph.hpp"
+#include "InlineSubgraph.hpp"
 #include "NautyLink.hpp"
 #include "Utility.hpp"
 
@@ -29,7 +30,7 @@ using std::unordered_map;
 void SubgraphProfile::add(Subgraph& currentSubgraph, NautyLink& nautylink)
 {
 	// first, get the label
-	std::string label = nautylink.nautylabel_helper(currentSubgraph);
+	const MotifCode label = nautylink.nautylabel_helper(currentSubgraph);
 
 	// get the current nodes
 	vector<vertex>& nodes = currentSubgraph.getNodes();
@@ -48,9 +49,33 @@ void SubgraphProfile::add(Subgraph& currentSubgraph, NautyLink& nautylink)
 }
 
 
-unordered_map<std::string, uint64_t> SubgraphProfile::getlabelFreqMap(int subgraphsize)
+/* Labels the whole batch at once, the inline subgraphs are counted as they
+ * are instead of being copied into legacy Subgraphs
+ */
+void SubgraphProfile::add_batch(vector<InlineSubgraph>& subgraphs, NautyLink& nautylink)
+{
+	vector<MotifCode> labels;
+	nautylink.nautylabel_batch(subgraphs, labels);
+
+	for (std::size_t i = 0; i < subgraphs.size(); i++)
+	{
+		vector<uint64_t>& counts = labelVertexFreqMapMap[labels[i]];
+
+		if (counts.empty())
+		{
+			counts.resize(graphsize, 0);
+		}
+
+		for (const vertex v : subgraphs[i])
+		{
+			counts[v] += 1;
+		}
+	}
+}
+
+unordered_map<MotifCode, uint64_t> SubgraphProfile::getlabelFreqMap(int subgraphsize)
 {
-	unordered_map <std::string, uint64_t> labelFreqMap;
+	unordered_map <MotifCode, uint64_t> labelFreqMap;
 
 	for (auto& p : labelVertexFreqMapMap)
 	{
@@ -60,9 +85,9 @@ unordered_map<std::string, uint64_t> SubgraphProfile::getlabelFreqMap(int subgra
 	return labelFreqMap;
 }
 
-unordered_map <std::string, double> SubgraphProfile::getRelativeFrequencies() const
+unordered_map <MotifCode, double> SubgraphProfile::getRelativeFrequencies() const
 {
-	unordered_map<std::string, double> result(labelVertexFreqMapMap.size());
+	unordered_map<MotifCode, double> result(labelVertexFreqMapMap.size());
 	auto totalcount = getTotalSubgaphCount();
 
 	for (auto& p : labelVertexFreqMapMap)
@@ -0,0 +1,129 @@
+/*
+ * File:   reader.cpp
+ *
+ * Reads small graph6, sparse6 and digraph6 files, with and without their
+ * >>format<< header, and checks the edges read or the error thrown.
+ */
+
+#include <cstdio>        // remove
+#include <fstream>       // ofstream
+#include <iostream>      // cout
+#include <stdexcept>     // invalid_argument
+#include <string>        // string
+#include <utility>       // pair
+#include <vector>        // vector
+
+#include "EdgeListReader.hpp"   // read_edge_list, EdgeList
+
+
+namespace
+{
+    //! written to the working directory and removed after every case
+    const std::string ks_str_PATH = "reader_test_graph.txt";
+
+
+    /** @brief Writes the content to a file and reads it in file order.*/
+    EdgeList read_content(const std::string& kr_str_CONTENT_)
+    {
+        {
+            std::ofstream file(ks_str_PATH, std::ios::binary);
+            file << kr_str_CONTENT_;
+        }
+
+        try
+        {
+            EdgeList edges = read_edge_list(ks_str_PATH, false, ParseOptions{1, false});
+            std::remove(ks_str_PATH.c_str());
+
+            return edges;
+        } // end try
+        catch (...)
+        {
+            std::remove(ks_str_PATH.c_str());
+            throw;
+        } // end catch
+    } // end method read_content
+
+
+    /** @brief Prints the outcome of a case.
+      * @return Whether it passed.
+      */
+    bool report(const std::string& kr_str_NAME_, const bool kb_PASSED_)
+    {
+        std::cout << (kb_PASSED_ ? "ok   " : "FAIL ") << kr_str_NAME_ << std::endl;
+
+        return kb_PASSED_;
+    } // end method report
+
+
+    /** @brief Reads the content and compares it with the expected graph.*/
+    bool check_graph(const std::string& kr_str_NAME_, const std::string& kr_str_CONTENT_, const bool kb_DIRECTED_,
+                     const std::size_t ku_li_VERTICES_, const std::vector<std::pair<vertex, vertex>>& kr_vect_EDGES_)
+    {
+        try
+        {
+            const EdgeList edges = read_content(kr_str_CONTENT_);
+
+            return report(kr_str_NAME_, kb_DIRECTED_ == edges.m_b_directed && ku_li_VERTICES_ == edges.mu_li_vertices
+                                        && kr_vect_EDGES_ == edges.m_vect_edges);
+        } // end try
+        catch (const std::exception& kr_error)
+        {
+            std::cout << "     " << kr_error.what() << std::endl;
+
+            return report(kr_str_NAME_, false);
+        } // end catch
+    } // end method check_graph
+
+
+    /** @brief Reads the content and expects std::invalid_argument.*/
+    bool check_rejected(const std::string& kr_str_NAME_, const std::string& kr_str_CONTENT_)
+    {
+        try
+        {
+            read_content(kr_str_CONTENT_);
+        } // end try
+        catch (const std::invalid_argument&)
+        {
+            return report(kr_str_NAME_, true);
+        } // end catch
+
+        return report(kr_str_NAME_, false);
+    } // end method check_rejected
+} // end namespace
+
+
+int main(void)
+{
+    // edges in the order they are encoded, graph6 by column of the upper
+    // triangle and digraph6 by row of the matrix
+    const std::vector<std::pair<vertex, vertex>> k_vect_GRAPH{{0, 2}, {1, 3}, {0, 4}, {3, 4}};
+    const std::vector<std::pair<vertex, vertex>> k_vect_DIGRAPH{{0, 2}, {0, 4}, {3, 1}, {3, 4}};
+    // the example of nauty's formats.txt
+    const std::vector<std::pair<vertex, vertex>> k_vect_SPARSE{{0, 1}, {0, 2}, {1, 2}, {5, 6}};
+
+    std::size_t u_li_failed{0};
+
+    auto count = [&u_li_failed](const bool kb_PASSED_)
+    {
+        u_li_failed += (false == kb_PASSED_);
+    }; // end lambda
+
+    count(check_graph("graph6", "DQc\n", false, 5, k_vect_GRAPH));
+    count(check_graph("graph6, header on the line", ">>graph6<<DQc\n", false, 5, k_vect_GRAPH));
+    count(check_graph("graph6, header alone on its line", ">>graph6<<\nDQc\n", false, 5, k_vect_GRAPH));
+    count(check_graph("graph6, header alone on a CRLF line", ">>graph6<<\r\nDQc\r\n", false, 5, k_vect_GRAPH));
+    count(check_graph("sparse6", ":Fa@x^\n", false, 7, k_vect_SPARSE));
+    count(check_graph("sparse6, header alone on its line", ">>sparse6<<\n:Fa@x^\n", false, 7, k_vect_SPARSE));
+    count(check_graph("digraph6", "&DI?AO?\n", true, 5, k_vect_DIGRAPH));
+    count(check_graph("digraph6, header on the line", ">>digraph6<<&DI?AO?\n", true, 5, k_vect_DIGRAPH));
+    count(check_graph("digraph6, header alone on its line", ">>digraph6<<\n&DI?AO?\n", true, 5, k_vect_DIGRAPH));
+
+    count(check_rejected("header without a graph", ">>digraph6<<\n"));
+    count(check_rejected("header followed by an empty line", ">>sparse6<<\n\n:Fa@x^\n"));
+    count(check_rejected("header followed by an edge list", ">>graph6<<\n0 1\n"));
+    count(check_rejected("vertex count outside the vertex range", ">>graph6<<\n~~~~~~~~\n"));
+    count(check_rejected("vertex count with a byte below 63", ">>graph6<<\n~\x01\x01\x01\n"));
+
+    return 0 == u_li_failed ? 0 : 1;
+} // end Main
@@ -0,0 +1,224 @@
+/*
+ * File:   regression.cpp
+ *
+ * Enumerates exampleGraph.txt and compares the motif counts with counts
+ * that were checked by brute force. Usage: regression <test dir> [labelg]
+ * The built-in nauty labeler is used when it was linked, labelg otherwise,
+ * and the test is skipped (exit code 77) if there is neither. With both,
+ * the labels they give every class MotifClassTable knows are compared.
+ */
+
+#include <algorithm>     // sort
+#include <cstdint>       // uint64_t
+#include <future>        // promise
+#include <iostream>      // cout, cerr
+#include <string>        // string
+#include <vector>        // vector
+
+#include "Config.hpp"           // _USE_NAUTY
+#include "CSRGraph.hpp"         // CSRGraph
+#include "EdgeListReader.hpp"   // read_edge_list
+#include "ESU_Parallel.hpp"     // ESU_Parallel
+#include "LabelGProvider.hpp"   // LabelGProvider, LabelGOptions
+#include "MotifClassTable.hpp"  // MotifClassTable
+#include "MotifCode.hpp"        // Motif_Code
+#include "NautyCanon.hpp"       // Nauty_Canon
+#include "SubgraphCount.hpp"    // SubgraphCount
+#include "ThreadPool.hpp"       // ThreadPool
+
+#include "loguru.hpp"
+
+
+namespace
+{
+    //! exit code meson counts as a skipped test
+    constexpr int k_SKIPPED = 77;
+
+    //! number of threads enumerating
+    constexpr std::size_t ku_li_THREADS = 4;
+
+
+    /** @brief The reference counts of one enumeration, ascending.
+      * @remark Labels differ between labelg builds, so the classes are only
+      *         compared by their counts, which are all distinct here.
+      */
+    struct Reference
+    {
+        //! motif size
+        int m_i_size;
+        //! whether the edges are read as directed
+        bool m_b_directed;
+        //! number of subgraphs of every class
+        std::vector<std::uint64_t> m_vect_counts;
+    }; // end struct Reference
+
+
+    // All of them match a brute force enumeration. Undirected size 5 is
+    // what the baseline counted, sizes 3 and 4 count 23 and 106 subgraphs
+    // more as the baseline dropped extensions by internal vertex 0 in
+    // RandESU::isExclusive. The baseline labeled digraphs as graphs, which
+    // merged the 5 directed classes of size 3 into 3.
+    const std::vector<Reference> k_vect_REFERENCES
+    {
+        {3, false, {283, 8753}},
+        {4, false, {64, 372, 1009, 5232, 42694, 78113}},
+        {5, false, {12, 14, 66, 186, 209, 238, 364, 604, 788, 1330, 1814, 2040, 4012, 5592, 22480, 35452, 39733, 58853, 214677, 707746, 968041}},
+        {3, true, {72, 211, 2144, 2225, 4384}}
+    };
+
+
+    /** @brief Enumerates the graph and compares the counts with the reference.
+      * @return Whether the counts matched.
+      */
+    bool check_counts(const std::string& kr_str_GRAPH_, const Reference& kr_REFERENCE_, ThreadPool& r_pool_, const LabelGOptions& kr_OPTIONS_)
+    {
+        const CSRGraph csr(read_edge_list(kr_str_GRAPH_, kr_REFERENCE_.m_b_directed));
+
+        SubgraphCount subc;
+
+        ESU_Parallel::enumerate<SubgraphCount>(csr, &subc, kr_REFERENCE_.m_i_size, &r_pool_, kr_OPTIONS_);
+
+        std::vector<std::uint64_t> vect_counts;
+
+        for (const auto& kr_label_count : subc.getlabelFreqMap())
+        {
+            vect_counts.push_back(kr_label_count.second);
+        } // end for kr_label_count
+
+        std::sort(vect_counts.begin(), vect_counts.end());
+
+        const bool kb_MATCH = (vect_counts == kr_REFERENCE_.m_vect_counts);
+
+        std::cout << (kb_MATCH ? "ok  " : "FAIL") << " size " << kr_REFERENCE_.m_i_size
+                  << (kr_REFERENCE_.m_b_directed ? " directed" : " undirected") << ": " << vect_counts.size() << " classes";
+
+        if (false == kb_MATCH)
+        {
+            std::cout << ", expected " << kr_REFERENCE_.m_vect_counts.size() << ", counts";
+
+            for (const auto ku_COUNT : vect_counts)
+            {
+                std::cout << " " << ku_COUNT;
+            } // end for ku_COUNT
+        } // end if
+
+        std::cout << std::endl;
+
+        return kb_MATCH;
+    } // end method check_counts
+
+
+#if _USE_NAUTY
+    /** @brief Labels the representative of every class of the given size
+      *        with the built-in labeler and with labelg.
+      * @return Whether both gave every class the same cannonical code.
+      * @remark A label cache persisted by one backend is read by the other,
+      *         so they have to agree.
+      */
+    bool check_backends(const std::size_t ku_li_SIZE_, const bool kb_DIRECTED_, const std::string& kr_str_LABELG_)
+    {
+        const MotifClassTable* p_table = MotifClassTable::get(ku_li_SIZE_, kb_DIRECTED_);
+
+        std::vector<MotifCode> vect_representatives;
+        std::vector<std::string> vect_g6;
+
+        for (std::size_t c{0}; c < p_table->n_classes(); c++)
+        {
+            vect_representatives.push_back(p_table->representative(c));
+            vect_g6.push_back(Motif_Code::to_g6(vect_representatives.back()));
+        } // end for c
+
+        LabelGProvider labelg;
+        labelg.start_up(LabelGOptions{kr_str_LABELG_});
+
+        std::promise<std::vector<std::string>> promise_labels;
+        auto future_labels = promise_labels.get_future();
+
+        labelg.add_jobs(vect_g6, [&](std::vector<std::string> vect_labels_){ promise_labels.set_value(std::move(vect_labels_)); });
+
+        const std::vector<std::string> vect_labelg = future_labels.get();
+
+        std::size_t u_li_differ{0};
+
+        for (std::size_t c{0}; c < vect_representatives.size(); c++)
+        {
+            // the code NautyLink gets from nauty, against labelg's answer
+            const MotifCode k_nauty = Nauty_Canon::canonical_code(vect_representatives[c]);
+
+            if (vect_labelg[c].empty() || k_nauty != Motif_Code::from_g6(vect_labelg[c]))
+            {
+                std::cout << "     " << vect_g6[c] << ": nauty " << Motif_Code::to_g6(k_nauty) << ", labelg " << vect_labelg[c] << std::endl;
+                u_li_differ++;
+            } // end if
+        } // end for c
+
+        std::cout << (0 == u_li_differ ? "ok  " : "FAIL") << " size " << ku_li_SIZE_ << (kb_DIRECTED_ ? " directed" : " undirected")
+                  << ": nauty and labelg label " << vect_representatives.size() - u_li_differ << " of " << vect_representatives.size()
+                  << " classes alike" << std::endl;
+
+        return 0 == u_li_differ;
+    } // end method check_backends
+#endif // _USE_NAUTY
+} // end namespace
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " [test dir] [labelg path]" << std::endl;
+        return 1;
+    } // end if
+
+    const std::string str_graph = std::string(argv[1]) + "/exampleGraph.txt";
+    const std::string str_labelg = argc > 2 ? argv[2] : "";
+
+    if (false == _USE_NAUTY && true == str_labelg.empty())
+    {
+        std::cout << "Neither nauty nor labelg is available, skipping" << std::endl;
+        return k_SKIPPED;
+    } // end if
+
+    loguru::g_stderr_verbosity = loguru::Verbosity_WARNING;
+
+    // an empty path selects the built-in labeler
+    const LabelGOptions labelg_options{_USE_NAUTY ? "" : str_labelg};
+
+    ThreadPool pool(ku_li_THREADS);
+    pool.Start_All_Threads();
+
+    std::size_t u_li_failed{0};
+
+    for (const auto& kr_reference : k_vect_REFERENCES)
+    {
+        if (false == check_counts(str_graph, kr_reference, pool, labelg_options))
+        {
+            u_li_failed++;
+        } // end if
+    } // end for kr_reference
+
+    pool.Kill_All();
+
+#if _USE_NAUTY
+    if (false == str_labelg.empty())
+    {
+        for (std::size_t k{3}; k <= MotifClassTable::ku_li_MAX_UNDIRECTED; k++)
+        {
+            if (false == check_backends(k, false, str_labelg))
+            {
+                u_li_failed++;
+            } // end if
+        } // end for k
+
+        for (std::size_t k{3}; k <= MotifClassTable::ku_li_MAX_DIRECTED; k++)
+        {
+            if (false == check_backends(k, true, str_labelg))
+            {
+                u_li_failed++;
+            } // end if
+        } // end for k
+    } // end if
+#endif // _USE_NAUTY
+
+    return 0 == u_li_failed ? 0 : 1;
+} // end Main
@@ -169,6 +169,7 @@ graph* readggg(FILE *f, graph *g, int reqm, int *pm, int *pn, boolean *digraph,
     *pm = m;
 
     stringtograph(s,g,m);
+    free(s);
     return g;
 }
 
@@ -196,6 +197,8 @@ main(int argc, char *argv[])
 	char *infilename,*outfilename;
 	FILE *infile,*outfile;
 	int ii,secret,loops;
+	char line[1024];
+	size_t len;
 	DEFAULTOPTIONS_TRACES(traces_opts);
 	TracesStats traces_stats;
 #if MAXN
@@ -242,6 +245,34 @@ main(int argc, char *argv[])
 
 	fmt = NULL;
 
+	/* Without an argument, labelg stays alive and labels one graph per
+	   line of stdin. Every answer is flushed immediately so that NemoLib
+	   can keep the pipes open and stream labels through this process. */
+	if (argc < 2)
+	{
+	    while (fgets(line,sizeof(line),infile) != NULL)
+	    {
+		len = strlen(line);
+		while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r'))
+		    line[--len] = '\0';
+		if (len == 0) continue;
+
+		g = readggg(infile,NULL,0,&m,&n,&digraph,line);
+#if !MAXN
+		DYNALLOC2(graph,h,h_sz,n,m,"labelg");
+#endif
+		loops = loopcount(g,m,n);
+		fcanonise_inv(g,m,n,h,fmt,invarproc[inv].entrypoint,
+		        mininvarlevel,maxinvarlevel,invararg,loops>0||digraph);
+		/* a digraph answered in graph6 would lose the arc directions */
+		if (digraph) writed6(outfile,h,m,n);
+		else         writeg6(outfile,h,m,n);
+		fflush(outfile);
+		FREES(g);
+	    }
+	    exit(0);
+	}
+
 	if ((g = readggg(infile,NULL,0,&m,&n,&digraph, argv[1])) == NULL);
 
 	#if !MAXN
@@ -253,7 +284,8 @@ main(int argc, char *argv[])
 	for (ii = 0; ii < secret; ++ii)
 		fcanonise_inv(g,m,n,h,fmt,invarproc[inv].entrypoint, mininvarlevel,maxinvarlevel,invararg,loops>0||digraph);
 	
-	writeg6(outfile,h,m,n);
+	if (digraph) writed6(outfile,h,m,n);
+	else         writeg6(outfile,h,m,n);
 
 	FREES(g);
 